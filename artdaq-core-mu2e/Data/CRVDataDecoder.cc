@@ -1,5 +1,7 @@
 #include "artdaq-core-mu2e/Data/CRVDataDecoder.hh"
 
+#include "artdaq-core-mu2e/Overlays/DTC_Types/DTC_Instrumentation.h"
+
 std::unique_ptr<mu2e::CRVDataDecoder::CRVROCStatusPacket> mu2e::CRVDataDecoder::GetCRVROCStatusPacket(size_t blockIndex) const
 {
 	auto dataPtr = dataAtBlockIndex(blockIndex);
@@ -15,6 +17,7 @@ bool mu2e::CRVDataDecoder::GetCRVHits(size_t blockIndex, std::vector<mu2e::CRVDa
         crvHits.clear();
         auto dataPtr = dataAtBlockIndex(blockIndex);
         if (dataPtr == nullptr) return false;
+        DTC_INSTRUMENT_SCOPE(timer, CRVDecode);
 
         auto crvRocHdr = reinterpret_cast<CRVROCStatusPacket const*>(dataPtr->GetData());
         size_t eventSize = 2*crvRocHdr->ControllerEventWordCount;
@@ -46,5 +49,6 @@ bool mu2e::CRVDataDecoder::GetCRVHits(size_t blockIndex, std::vector<mu2e::CRVDa
           }
         }
 
+        DTC_INSTRUMENT_ADD(timer, dataPtr->byteSize, crvHits.size());
         return true;
 }
@@ -1,5 +1,7 @@
 #include "artdaq-core-mu2e/Data/CalorimeterDataDecoder.hh"
 
+#include "artdaq-core-mu2e/Overlays/DTC_Types/DTC_Instrumentation.h"
+
 #include "TRACE/tracemf.h"
 
 #include <algorithm>
@@ -13,10 +15,10 @@ namespace mu2e {
   {
     if (block_count() > 0){
       auto dataPtr = dataAtBlockIndex(0);// Return pointer to beginning of DataBlock at given DataBlock index( returns type DTCLib::DTC_DataBlock)
-      auto hdr = dataPtr->GetHeader(); // get the header
+      auto hdr = dataPtr->GetHeaderView(); // get the header
       // check that the subsystem is the calo and the version is correct:
-      if (hdr->GetSubsystem() != DTCLib::DTC_Subsystem_Calorimeter || hdr->GetVersion() > 1){
-        //TLOG(TLVL_WARNING) << "CalorimeterDataDecoder CONSTRUCTOR: First block has unexpected type/version " << static_cast<int>(hdr->GetSubsystem()) << "/" << static_cast<int>(hdr->GetVersion()) << " (expected " << static_cast<int>(DTCLib::DTC_Subsystem_Calorimeter) << "/[0,1])";
+      if (hdr.GetSubsystem() != DTCLib::DTC_Subsystem_Calorimeter || hdr.GetVersion() > 1){
+        //TLOG(TLVL_WARNING) << "CalorimeterDataDecoder CONSTRUCTOR: First block has unexpected type/version " << static_cast<int>(hdr.GetSubsystem()) << "/" << static_cast<int>(hdr.GetVersion()) << " (expected " << static_cast<int>(DTCLib::DTC_Subsystem_Calorimeter) << "/[0,1])";
       }
     }
   }
@@ -27,9 +29,9 @@ namespace mu2e {
     //event_.GetDataBlockCount() > 0
     if (block_count() > 0){
       auto dataPtr = dataAtBlockIndex(0);
-      auto hdr = dataPtr->GetHeader();
-      if (hdr->GetSubsystem() != DTCLib::DTC_Subsystem_Calorimeter || hdr->GetVersion() > 1){
-        //TLOG(TLVL_WARNING) << "CalorimeterDataDecoder CONSTRUCTOR: First block has unexpected type/version " << hdr->GetSubsystem() << "/" << static_cast<int>(hdr->GetVersion()) << " (expected " << static_cast<int>(DTCLib::DTC_Subsystem_Calorimeter) << "/[0,1])";
+      auto hdr = dataPtr->GetHeaderView();
+      if (hdr.GetSubsystem() != DTCLib::DTC_Subsystem_Calorimeter || hdr.GetVersion() > 1){
+        //TLOG(TLVL_WARNING) << "CalorimeterDataDecoder CONSTRUCTOR: First block has unexpected type/version " << hdr.GetSubsystem() << "/" << static_cast<int>(hdr.GetVersion()) << " (expected " << static_cast<int>(DTCLib::DTC_Subsystem_Calorimeter) << "/[0,1])";
       }
     }
   }
@@ -44,6 +46,7 @@ namespace mu2e {
     // get data block at given index
     auto dataPtr = dataAtBlockIndex(blockIndex);
     if (dataPtr == nullptr) return output;
+    DTC_INSTRUMENT_SCOPE(timer, CalorimeterDecode);
   
     // check size of hit data packet
     static_assert(sizeof(mu2e::CalorimeterDataDecoder::CalorimeterHitDataPacket) % 2 == 0);
@@ -76,6 +79,7 @@ namespace mu2e {
       pos += nSamples;
       count++;
     }
+    DTC_INSTRUMENT_ADD(timer, dataPtr->byteSize, output->size());
     return output;
   }
 
@@ -90,9 +94,9 @@ namespace mu2e {
     DTCLib::DTC_DataBlock const * dataBlock = dataAtBlockIndex(blockIndex);
     if (dataBlock == nullptr) return output;
 
-    DTCLib::DTC_DataHeaderPacket* blockHeader = dataBlock->GetHeader().get();
+    auto blockHeader = dataBlock->GetHeaderView();
     size_t blockSize = dataBlock->byteSize;
-    size_t nPackets = blockHeader->GetPacketCount();
+    size_t nPackets = blockHeader.GetPacketCount();
     size_t dataSize = blockSize - 16;
 
     auto blockDataPtr = dataBlock->GetData();
@@ -163,6 +167,7 @@ namespace mu2e {
   
     auto dataPtr = dataAtBlockIndex(blockIndex);
     if (dataPtr == nullptr) return output;
+    DTC_INSTRUMENT_SCOPE(timer, CalorimeterDecode);
   
     static_assert(sizeof(CalorimeterHitDataPacket) % 2 == 0);
   
@@ -184,6 +189,7 @@ namespace mu2e {
       auto nSamples = output.back().first.NumberOfSamples;
       pos += nSamples;
     }
+    DTC_INSTRUMENT_ADD(timer, dataPtr->byteSize, output.size());
     return output;
   }
 
@@ -200,14 +206,14 @@ namespace mu2e {
       return output;
     }
 
-    if(dataBlock->GetHeader()->GetSubsystem() != DTCLib::DTC_Subsystem_Calorimeter) {
-      TLOG(TLVL_DEBUG) << "CalorimeterDataDecoder::GetCalorimeterHitTestData : this block is from different subsystem: " << dataBlock->GetHeader()->GetSubsystem();
+    if(dataBlock->GetHeaderView().GetSubsystem() != DTCLib::DTC_Subsystem_Calorimeter) {
+      TLOG(TLVL_DEBUG) << "CalorimeterDataDecoder::GetCalorimeterHitTestData : this block is from different subsystem: " << dataBlock->GetHeaderView().GetSubsystem();
       return output;
     }
 
-    DTCLib::DTC_DataHeaderPacket* blockHeader = dataBlock->GetHeader().get();
+    auto blockHeader = dataBlock->GetHeaderView();
     size_t blockSize = dataBlock->byteSize;
-    size_t nPackets = blockHeader->GetPacketCount();
+    size_t nPackets = blockHeader.GetPacketCount();
     size_t dataSize = blockSize - 16;
 
     auto blockDataPtr = dataBlock->GetData();
@@ -303,9 +309,9 @@ namespace mu2e {
     DTCLib::DTC_DataBlock const * dataBlock = dataAtBlockIndex(blockIndex);
     if (dataBlock == nullptr) return output;
 
-    DTCLib::DTC_DataHeaderPacket* blockHeader = dataBlock->GetHeader().get();
+    auto blockHeader = dataBlock->GetHeaderView();
     size_t blockSize = dataBlock->byteSize;
-    size_t nPackets = blockHeader->GetPacketCount();
+    size_t nPackets = blockHeader.GetPacketCount();
     size_t dataSize = blockSize - 16;
 
     auto blockDataPtr = dataBlock->GetData();
@@ -344,9 +350,9 @@ namespace mu2e {
     DTCLib::DTC_DataBlock const * dataBlock = dataAtBlockIndex(blockIndex);
     if (dataBlock == nullptr) return output;
 
-    DTCLib::DTC_DataHeaderPacket* blockHeader = dataBlock->GetHeader().get();
+    auto blockHeader = dataBlock->GetHeaderView();
     size_t blockSize = dataBlock->byteSize;
-    size_t nPackets = blockHeader->GetPacketCount();
+    size_t nPackets = blockHeader.GetPacketCount();
     size_t dataSize = blockSize - 16;
 
     auto blockDataPtr = dataBlock->GetData();
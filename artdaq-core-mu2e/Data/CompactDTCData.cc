@@ -0,0 +1,181 @@
+#include "artdaq-core-mu2e/Data/CompactDTCData.hh"
+
+#include "artdaq-core-mu2e/Overlays/DTC_Packets/DTC_SubEventHeader.h"
+
+#include "TRACE/tracemf.h"
+
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+// Packed subevent header layout:
+//   word 0: EWT (48) | DTC ID (8) | DTC MAC (8)
+//   word 1: event mode (40) | partition ID (8) | EVB mode (8) | format version (8)
+//   word 2: link subsystems (6 x 3) | reserved (6) | EMTDC (8) | index of first block (32)
+//   word 3: link status (6 x 8) | reserved (16)
+
+mu2e::CompactDTCData::CompactDTCData(DTCLib::DTC_Event const& event, uint8_t subsystem)
+{
+	size_t bytes = 0;
+	for (auto const& subEvent : event.GetSubEvents())
+	{
+		bytes += subEvent.GetSubEventByteCount() - sizeof(DTCLib::DTC_SubEventHeader);
+	}
+	payload_.reserve(bytes);
+	subEventIndex_.reserve(event.GetSubEventCount() * kWordsPerSubEvent);
+
+	for (auto const& subEvent : event.GetSubEvents())
+	{
+		addSubEvent(subEvent, subsystem);
+	}
+}
+
+std::array<mu2e::CompactDTCData, 8> mu2e::CompactDTCData::splitBySubsystem(DTCLib::DTC_Event const& event)
+{
+	std::array<CompactDTCData, 8> output;
+	for (auto const& subEvent : event.GetSubEvents())
+	{
+		uint8_t added = 0;  // Each subsystem only once, even if several links read it out
+		for (uint8_t link = 0; link < 6; ++link)
+		{
+			auto subsystem = static_cast<uint8_t>(subEvent.GetSubsystem(static_cast<DTCLib::DTC_Link_ID>(link)) & 0x7);
+			if (added & (1 << subsystem)) continue;
+			added |= 1 << subsystem;
+			output[subsystem].addSubEvent(subEvent);
+		}
+	}
+	return output;
+}
+
+bool mu2e::CompactDTCData::addSubEvent(DTCLib::DTC_SubEvent const& subEvent, uint8_t subsystem)
+{
+	if (subsystem != kAllSubsystems && !subEvent.HasSubsystem(static_cast<DTCLib::DTC_Subsystem>(subsystem))) return false;
+
+	auto const& blocks = subEvent.GetDataBlocks();
+	size_t bytes = 0;
+	for (auto const& block : blocks)
+	{
+		bytes += block.byteSize;
+	}
+	if (payload_.size() + bytes > std::numeric_limits<uint32_t>::max())
+	{
+		TLOG(TLVL_ERROR, "CompactDTCData") << "Adding a subevent of " << bytes << " bytes would exceed the 4 GB limit of CompactDTCData";
+		throw std::length_error("CompactDTCData is limited to 4 GB of block data");
+	}
+
+	auto const* hdr = subEvent.GetHeader();
+	uint64_t subsystems = 0;
+	for (size_t link = 0; link < 6; ++link)
+	{
+		subsystems |= static_cast<uint64_t>(subEvent.GetSubsystem(static_cast<DTCLib::DTC_Link_ID>(link)) & 0x7) << (3 * link);
+	}
+	uint64_t status = static_cast<uint64_t>(hdr->link0_status) | (static_cast<uint64_t>(hdr->link1_status) << 8) | (static_cast<uint64_t>(hdr->link2_status) << 16) |
+					  (static_cast<uint64_t>(hdr->link3_status) << 24) | (static_cast<uint64_t>(hdr->link4_status) << 32) | (static_cast<uint64_t>(hdr->link5_status) << 40);
+
+	subEventIndex_.push_back(DTCLib::DTC_EWT(static_cast<uint32_t>(hdr->event_tag_low), static_cast<uint16_t>(hdr->event_tag_high)).value() |
+							 (static_cast<uint64_t>(hdr->source_dtc_id) << 48) | (static_cast<uint64_t>(hdr->dtc_mac) << 56));
+	subEventIndex_.push_back(hdr->event_mode | (static_cast<uint64_t>(hdr->partition_id) << 40) | (static_cast<uint64_t>(hdr->evb_mode) << 48) |
+							 (static_cast<uint64_t>(hdr->subevent_format_version) << 56));
+	subEventIndex_.push_back(subsystems | (static_cast<uint64_t>(hdr->emtdc) << 24) | (static_cast<uint64_t>(blockEnd_.size()) << 32));
+	subEventIndex_.push_back(status);
+
+	auto offset = payload_.size();
+	payload_.resize(offset + bytes);
+	for (auto const& block : blocks)
+	{
+		memcpy(payload_.data() + offset, block.blockPointer, block.byteSize);
+		offset += block.byteSize;
+		blockEnd_.push_back(static_cast<uint32_t>(offset));
+	}
+	return true;
+}
+
+void mu2e::CompactDTCData::clear()
+{
+	payload_.clear();
+	blockEnd_.clear();
+	subEventIndex_.clear();
+}
+
+size_t mu2e::CompactDTCData::blockEnd(size_t blockIndex) const
+{
+	if (blockIndex >= blockEnd_.size()) throw std::out_of_range("Block index " + std::to_string(blockIndex) + " is out of range (size: " + std::to_string(blockEnd_.size()) + ")");
+	return blockEnd_[blockIndex];
+}
+
+mu2e::CompactDTCData::SubEventInfo mu2e::CompactDTCData::subEventInfo(size_t subEventIndex) const
+{
+	if (subEventIndex >= subEventCount()) throw std::out_of_range("Subevent index " + std::to_string(subEventIndex) + " is out of range (size: " + std::to_string(subEventCount()) + ")");
+
+	auto const* words = subEventIndex_.data() + subEventIndex * kWordsPerSubEvent;
+	SubEventInfo info;
+	info.ewt = DTCLib::DTC_EWT(words[0]);
+	info.dtcID = static_cast<uint8_t>(words[0] >> 48);
+	info.dtcMAC = static_cast<uint8_t>(words[0] >> 56);
+	info.eventMode = words[1] & 0xFFFFFFFFFFULL;
+	info.partitionID = static_cast<uint8_t>(words[1] >> 40);
+	info.evbMode = static_cast<uint8_t>(words[1] >> 48);
+	info.formatVersion = static_cast<uint8_t>(words[1] >> 56);
+	info.emtdc = static_cast<uint8_t>(words[2] >> 24);
+	for (size_t link = 0; link < 6; ++link)
+	{
+		info.linkSubsystems[link] = static_cast<uint8_t>((words[2] >> (3 * link)) & 0x7);
+		info.linkStatus[link] = static_cast<uint8_t>(words[3] >> (8 * link));
+	}
+
+	info.firstBlock = words[2] >> 32;
+	auto nextFirst = subEventIndex + 1 < subEventCount() ? words[kWordsPerSubEvent + 2] >> 32 : blockEnd_.size();
+	info.blockCount = nextFirst - info.firstBlock;
+	return info;
+}
+
+DTCLib::DTC_DataBlock mu2e::CompactDTCData::block(size_t blockIndex) const
+{
+	auto end = blockEnd(blockIndex);
+	auto begin = blockBegin(blockIndex);
+	return DTCLib::DTC_DataBlock(payload_.data() + begin, end - begin);
+}
+
+std::vector<uint8_t> mu2e::CompactDTCData::subEventBytes(size_t subEventIndex) const
+{
+	auto info = subEventInfo(subEventIndex);
+	auto begin = info.blockCount > 0 ? blockBegin(info.firstBlock) : 0;
+	auto end = info.blockCount > 0 ? blockEnd(info.firstBlock + info.blockCount - 1) : 0;
+
+	DTCLib::DTC_SubEventHeader hdr;
+	hdr.inclusive_subevent_byte_count = sizeof(hdr) + end - begin;
+	hdr.event_tag_low = info.ewt.low();
+	hdr.event_tag_high = info.ewt.high();
+	hdr.num_rocs = info.blockCount;
+	hdr.event_mode = info.eventMode;
+	hdr.dtc_mac = info.dtcMAC;
+	hdr.partition_id = info.partitionID;
+	hdr.evb_mode = info.evbMode;
+	hdr.source_dtc_id = info.dtcID;
+	hdr.link0_subsystem = info.linkSubsystems[0];
+	hdr.link1_subsystem = info.linkSubsystems[1];
+	hdr.link2_subsystem = info.linkSubsystems[2];
+	hdr.link3_subsystem = info.linkSubsystems[3];
+	hdr.link4_subsystem = info.linkSubsystems[4];
+	hdr.link5_subsystem = info.linkSubsystems[5];
+	hdr.link0_status = info.linkStatus[0];
+	hdr.link1_status = info.linkStatus[1];
+	hdr.link2_status = info.linkStatus[2];
+	hdr.link3_status = info.linkStatus[3];
+	hdr.link4_status = info.linkStatus[4];
+	hdr.link5_status = info.linkStatus[5];
+	hdr.subevent_format_version = info.formatVersion;
+	hdr.emtdc = info.emtdc;
+
+	std::vector<uint8_t> output(sizeof(hdr) + end - begin);
+	memcpy(output.data(), &hdr, sizeof(hdr));
+	if (end > begin) memcpy(output.data() + sizeof(hdr), payload_.data() + begin, end - begin);
+	return output;
+}
+
+std::ostream& mu2e::operator<<(std::ostream& os, CompactDTCData const& f)
+{
+	os << "CompactDTCData " << std::dec << ", subevent count: " << f.subEventCount() << ", block count: " << f.blockCount() << ", byte count: " << f.byteCount() << "\n";
+	return os;
+}
@@ -0,0 +1,96 @@
+#ifndef ARTDAQ_CORE_MU2E_DATA_COMPACTDTCDATA_HH
+#define ARTDAQ_CORE_MU2E_DATA_COMPACTDTCDATA_HH
+
+#include "artdaq-core-mu2e/Overlays/DTC_Packets/DTC_DataBlock.h"
+#include "artdaq-core-mu2e/Overlays/DTC_Packets/DTC_Event.h"
+#include "artdaq-core-mu2e/Overlays/DTC_Packets/DTC_SubEvent.h"
+#include "artdaq-core-mu2e/Overlays/DTC_Types/DTC_EWT.h"
+#include "artdaq-core-mu2e/Overlays/DTC_Types/DTC_Subsystem.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+// Compact persistent form of the DTC subevents of one event, as an alternative to a DTCDataDecoders product.
+// All ROC blocks are stored back to back in one byte vector, indexed by a vector of block end offsets; each subevent
+// header is packed into four 64-bit words. The product has no per-subevent objects and no transient members, so ROOT
+// streams it as three flat arrays of primitives.
+
+namespace mu2e {
+class CompactDTCData;
+
+// Let the "<<" operator dump the CompactDTCData's summary to stdout
+std::ostream& operator<<(std::ostream&, CompactDTCData const&);
+}  // namespace mu2e
+
+class mu2e::CompactDTCData
+{
+public:
+	static constexpr uint8_t kAllSubsystems = 0xFF;  ///< Subsystem filter value that keeps every subevent
+
+	/// Subevent header fields kept in the compact form. The per-link DRP RX latencies are not kept.
+	struct SubEventInfo
+	{
+		DTCLib::DTC_EWT ewt;
+		uint64_t eventMode{0};
+		uint8_t dtcID{0};
+		uint8_t dtcMAC{0};
+		uint8_t partitionID{0};
+		uint8_t evbMode{0};
+		uint8_t formatVersion{0};
+		uint8_t emtdc{0};
+		std::array<uint8_t, 6> linkSubsystems{};
+		std::array<uint8_t, 6> linkStatus{};
+		size_t firstBlock{0};
+		size_t blockCount{0};
+	};
+
+	CompactDTCData() {}
+
+	/// Store the subevents of an event, optionally only those reading out the given subsystem
+	explicit CompactDTCData(DTCLib::DTC_Event const& event, uint8_t subsystem = kAllSubsystems);
+
+	/// Split an event into one product per subsystem (indexed by DTCLib::DTC_Subsystem). A subevent with links of
+	/// several subsystems is stored in each of them, as with DTC_Event::GetSubsystemData().
+	static std::array<CompactDTCData, 8> splitBySubsystem(DTCLib::DTC_Event const& event);
+
+	/// Append a subevent. Returns false, storing nothing, if it does not read out the given subsystem.
+	bool addSubEvent(DTCLib::DTC_SubEvent const& subEvent, uint8_t subsystem = kAllSubsystems);
+
+	void clear();
+
+	size_t subEventCount() const { return subEventIndex_.size() / kWordsPerSubEvent; }
+	size_t blockCount() const { return blockEnd_.size(); }
+	size_t byteCount() const { return payload_.size(); }
+
+	/// Header fields of a subevent (throws std::out_of_range)
+	SubEventInfo subEventInfo(size_t subEventIndex) const;
+
+	/// Non-owning DTC_DataBlock over a stored ROC block; valid as long as this object is unchanged (throws std::out_of_range)
+	DTCLib::DTC_DataBlock block(size_t blockIndex) const;
+	size_t blockSizeBytes(size_t blockIndex) const { return blockEnd(blockIndex) - blockBegin(blockIndex); }
+
+	/// Rebuild the raw bytes of a subevent (header followed by its blocks), as stored by DTCDataDecoder
+	std::vector<uint8_t> subEventBytes(size_t subEventIndex) const;
+
+	/// Construct a DTCDataDecoder, or one of its subsystem-specific subclasses, for a subevent
+	template<typename Decoder>
+	Decoder makeDecoder(size_t subEventIndex) const
+	{
+		return Decoder(subEventBytes(subEventIndex));
+	}
+
+private:
+	static constexpr size_t kWordsPerSubEvent = 4;
+
+	size_t blockBegin(size_t blockIndex) const { return blockIndex == 0 ? 0 : blockEnd_[blockIndex - 1]; }
+	size_t blockEnd(size_t blockIndex) const;
+
+	std::vector<uint8_t> payload_;         // ROC blocks (Data Header packet and payload) of all subevents
+	std::vector<uint32_t> blockEnd_;       // End offset of each block in payload_
+	std::vector<uint64_t> subEventIndex_;  // Packed subevent headers, kWordsPerSubEvent words each
+};
+
+#endif /* ARTDAQ_CORE_MU2E_DATA_COMPACTDTCDATA_HH */
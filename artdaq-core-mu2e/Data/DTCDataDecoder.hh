@@ -6,13 +6,16 @@
 #include "artdaq-core-mu2e/Overlays/DTC_Packets/DTC_SubEvent.h"
 #include "artdaq-core-mu2e/Overlays/DTC_Packets/DTC_DataBlock.h"
 
+#include <atomic>
 #include <iostream>
+#include <thread>
 #include <vector>
 
 // Implementation of "DTCDataDecoder", an artdaq::Fragment overlay class
 // May contain multiple DataBlocks from the same ROC
 
 namespace mu2e {
+class DecoderSetupFlag;
 struct DTCDataDecoder;
 using DTCDataDecoders = std::vector<DTCDataDecoder>;
 
@@ -20,6 +23,57 @@ using DTCDataDecoders = std::vector<DTCDataDecoder>;
 std::ostream &operator<<(std::ostream &, DTCDataDecoder const &);
 }  // namespace mu2e
 
+// Once-only initialization of state which a decoder builds lazily from its data. The fast path is a single acquire
+// load, so const accessors can be called concurrently from several threads (e.g. art schedules sharing a product).
+// Copying a decoder copies its data but not the derived state (which points into the data), so the copy gets an unset
+// flag and rebuilds it on first use.
+class mu2e::DecoderSetupFlag
+{
+public:
+	DecoderSetupFlag() = default;
+	DecoderSetupFlag(DecoderSetupFlag const&) {}
+	DecoderSetupFlag& operator=(DecoderSetupFlag const&)
+	{
+		reset();
+		return *this;
+	}
+
+	// Run f unless it has already completed. Concurrent callers wait for the first one; if f throws, the flag is left
+	// unset and the exception is propagated.
+	template<typename F>
+	void call(F&& f) const
+	{
+		if (state_.load(std::memory_order_acquire) == kDone) return;
+
+		int expected = kUnset;
+		while (!state_.compare_exchange_weak(expected, kRunning, std::memory_order_acquire, std::memory_order_acquire))
+		{
+			if (expected == kDone) return;
+			std::this_thread::yield();
+			expected = kUnset;
+		}
+		try
+		{
+			f();
+		}
+		catch (...)
+		{
+			state_.store(kUnset, std::memory_order_release);
+			throw;
+		}
+		state_.store(kDone, std::memory_order_release);
+	}
+
+	// Mark the state as stale. Not thread-safe with respect to call(); only for use from non-const members.
+	void reset() { state_.store(kUnset, std::memory_order_relaxed); }
+
+private:
+	static constexpr int kUnset = 0;
+	static constexpr int kRunning = 1;
+	static constexpr int kDone = 2;
+	mutable std::atomic<int> state_{kUnset};
+};
+
 struct mu2e::DTCDataDecoder
 {
 	DTCDataDecoder() {}
@@ -30,56 +84,53 @@ struct mu2e::DTCDataDecoder
 
 	explicit DTCDataDecoder(DTCLib::DTC_SubEvent const &se)
 	{
-		data_ = std::vector<uint8_t>(se.GetSubEventByteCount());
-		memcpy(&data_[0], se.GetHeader(), sizeof(DTCLib::DTC_SubEventHeader));
-		size_t offset = sizeof(DTCLib::DTC_SubEventHeader);
+		// Append instead of memcpy into a sized vector, so that the bytes are written once rather than zeroed first
+		data_.reserve(se.GetSubEventByteCount());
+		auto header = reinterpret_cast<const uint8_t*>(se.GetHeader());
+		data_.insert(data_.end(), header, header + sizeof(DTCLib::DTC_SubEventHeader));
 
 		for(auto& bl : se.GetDataBlocks()) {
-			memcpy(&data_[0] + offset, bl.blockPointer, bl.byteSize);
-			offset += bl.byteSize;
+			auto block = static_cast<const uint8_t*>(bl.blockPointer);
+			data_.insert(data_.end(), block, block + bl.byteSize);
 		}
-		
-		auto ptr = data_.data();
-		event_ = DTCLib::DTC_SubEvent(ptr);	
-		event_.SetupSubEvent();
-		setup_ = true;
+		if (data_.size() < se.GetSubEventByteCount()) data_.resize(se.GetSubEventByteCount());
+
+		setup_event();
 	}
 
+	// Parse the subevent in data_, once. Called by every accessor; thread-safe. Decoders read block headers through
+	// DTC_DataBlock::GetHeaderView(), which decodes in place and keeps no lazy state.
 	void setup_event() const {
-		auto ptr = data_.data();
-		event_ = DTCLib::DTC_SubEvent(ptr);	
-		event_.SetupSubEvent();
-		setup_ = true;
-		}
+		setup_.call([this] {
+			event_ = DTCLib::DTC_SubEvent(data_.data());
+			event_.SetupSubEvent();
+		});
+	}
 
 	// const getter functions for the data in the header
 	size_t block_count() const {
-	  if (!setup_) {setup_event();}
-	  return event_.GetDataBlockCount(); }
+	  return subEvent().GetDataBlockCount(); }
 
 	// Return size of block at given DataBlock index
 	size_t blockSizeBytes(size_t blockIndex) const
 	{
-		if (!setup_) setup_event();
-		if (blockIndex > block_count())
+		if (blockIndex >= block_count())
 		{
 			return 0;
 		}
 
-		return event_.GetDataBlock(blockIndex)->byteSize;
+		return subEvent().GetDataBlock(blockIndex)->byteSize;
 	}
 
 	// Return pointer to beginning of DataBlock at given DataBlock index
 	DTCLib::DTC_DataBlock const *dataAtBlockIndex(size_t blockIndex) const
 	{
-		if (!setup_) setup_event();
-		if (blockIndex > block_count()) return nullptr;
-		return event_.GetDataBlock(blockIndex);
+		if (blockIndex >= block_count()) return nullptr;
+		return subEvent().GetDataBlock(blockIndex);
 	}
 
 	void printPacketAtByte(size_t blockIndex, size_t byteIdx) const
 	{
-		if (!setup_) setup_event();
 		auto dataPtr = reinterpret_cast<uint16_t const *>(reinterpret_cast<uint8_t const *>(dataAtBlockIndex(blockIndex)->GetData()) + byteIdx);
 		std::cout << "\t\t"
 				  << "Packet Bits (128): " << std::endl;
@@ -110,10 +161,17 @@ struct mu2e::DTCDataDecoder
 		return;
 	}
 	
-	mutable bool setup_{false};
 	std::vector<uint8_t> data_;
 
-	mutable DTCLib::DTC_SubEvent event_;  //! presume transient
+private:
+	DTCLib::DTC_SubEvent const& subEvent() const
+	{
+		setup_event();
+		return event_;
+	}
+
+	DecoderSetupFlag setup_;              //! transient
+	mutable DTCLib::DTC_SubEvent event_;  //! transient, only written under setup_
 };
 
 #endif /* mu2e_artdaq_Overlays_DTCDataDecoder_hh */
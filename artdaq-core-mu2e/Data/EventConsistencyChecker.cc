@@ -0,0 +1,73 @@
+#include "artdaq-core-mu2e/Data/EventConsistencyChecker.hh"
+
+#include "artdaq-core-mu2e/Overlays/DTC_Types/DTC_EWT.h"
+
+#include "TRACE/tracemf.h"
+
+mu2e::EventConsistencyChecker::EventConsistencyChecker(Config const& config)
+	: config_(config)
+{
+	for (auto id : config_.expectedDTCs)
+	{
+		expectedMask_[id >> 6] |= uint64_t(1) << (id & 0x3F);
+	}
+}
+
+mu2e::EventConsistencyChecker::Result mu2e::EventConsistencyChecker::Check(DTCLib::DTC_Event const& event)
+{
+	Result result;
+	auto const* hdr = event.GetHeader();
+	auto const ewt = DTCLib::DTC_EWT(static_cast<uint32_t>(hdr->event_tag_low), static_cast<uint16_t>(hdr->event_tag_high));
+
+	DTCMask seen{};
+	for (auto const& subEvent : event.GetSubEvents())
+	{
+		auto const* subHdr = subEvent.GetHeader();
+		if (DTCLib::DTC_EWT(static_cast<uint32_t>(subHdr->event_tag_low), static_cast<uint16_t>(subHdr->event_tag_high)) != ewt) ++result.badSubEvents;
+
+		uint8_t id = subHdr->source_dtc_id;
+		seen[id >> 6] |= uint64_t(1) << (id & 0x3F);
+
+		// Read the EWT straight from bytes 6-11 of each ROC Data Header packet, without decoding the header
+		for (auto const& block : subEvent.GetDataBlocks())
+		{
+			if (block.byteSize < 16) continue;
+			if (DTCLib::DTC_EWT::LoadLE(static_cast<const uint8_t*>(block.blockPointer) + 6) != ewt) ++result.badBlocks;
+		}
+	}
+
+	result.ewt_check = result.badSubEvents == 0 && result.badBlocks == 0;
+	if (!config_.expectedDTCs.empty())
+	{
+		for (size_t ii = 0; ii < seen.size(); ++ii)
+		{
+			if ((expectedMask_[ii] & ~seen[ii]) != 0) result.dtc_check = false;
+		}
+		result.ndtc_check = NDTCCheck(event.GetSubEventCount(), config_.expectedDTCs.size());
+	}
+	result.rnr_check = RoundRobinCheck(ewt.value(), hdr->evb_id, config_.nEVBs);
+
+	++events_;
+	if (!result.ewt_check) ++ewtFailures_;
+	if (!result.dtc_check) ++dtcFailures_;
+	if (!result.ndtc_check) ++ndtcFailures_;
+	if (!result.rnr_check) ++rnrFailures_;
+
+	if (!(result.ewt_check && result.dtc_check && result.ndtc_check && result.rnr_check))
+	{
+		TLOG(TLVL_DEBUG + 5, "EventConsistencyChecker") << "Event " << ewt.value() << ": ewt_check=" << result.ewt_check << " (" << result.badSubEvents << " subevents, "
+														<< result.badBlocks << " blocks mismatched), dtc_check=" << result.dtc_check << ", ndtc_check=" << result.ndtc_check
+														<< ", rnr_check=" << result.rnr_check;
+	}
+	return result;
+}
+
+mu2e::EventConsistencyChecker::Result mu2e::EventConsistencyChecker::Check(DTCLib::DTC_Event const& event, EventHeader& header)
+{
+	auto result = Check(event);
+	header.ewt_check = result.ewt_check;
+	header.dtc_check = result.dtc_check;
+	header.ndtc_check = result.ndtc_check;
+	header.rnr_check = result.rnr_check;
+	return result;
+}
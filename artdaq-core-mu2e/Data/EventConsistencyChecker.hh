@@ -0,0 +1,97 @@
+#ifndef mu2e_artdaq_core_Data_EventConsistencyChecker_hh
+#define mu2e_artdaq_core_Data_EventConsistencyChecker_hh
+
+#include "artdaq-core-mu2e/Data/EventHeader.hh"
+
+#include "artdaq-core-mu2e/Overlays/DTC_Packets/DTC_Event.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace mu2e {
+
+/// <summary>
+/// Streaming consistency checker for assembled DTC_Events. A single pass over the subevents and the headers of
+/// their ROC blocks computes all four EventHeader check bits (1 = passed, as after EventHeader::initErrorChecks()):
+///   ewt_check   every subevent and ROC block carries the EWT of the event header
+///   dtc_check   every configured DTC contributed a subevent
+///   ndtc_check  the number of subevents matches the number of configured DTCs
+///   rnr_check   the event was built by the event builder the round robin assigns to its EWT (EWT % nEVBs == evb_id)
+/// Running failure counts are kept for monitoring.
+/// </summary>
+class EventConsistencyChecker
+{
+public:
+	struct Config
+	{
+		std::vector<uint8_t> expectedDTCs;  ///< IDs of the DTCs expected in every event (empty: skip dtc_check and ndtc_check)
+		uint8_t nEVBs{0};                   ///< Number of event builders in the round robin (0: skip rnr_check)
+	};
+
+	struct Result
+	{
+		bool ewt_check{true};
+		bool dtc_check{true};
+		bool ndtc_check{true};
+		bool rnr_check{true};
+		size_t badSubEvents{0};  ///< Subevents whose EWT differs from the event header
+		size_t badBlocks{0};     ///< ROC blocks whose EWT differs from the event header
+	};
+
+	explicit EventConsistencyChecker(Config const& config);
+
+	/// <summary>
+	/// Check one event
+	/// </summary>
+	/// <param name="event">Event to check</param>
+	/// <returns>Check results</returns>
+	Result Check(DTCLib::DTC_Event const& event);
+
+	/// <summary>
+	/// Check one event and store the results in the check bits of its EventHeader
+	/// </summary>
+	/// <param name="event">Event to check</param>
+	/// <param name="header">EventHeader whose check bits are set</param>
+	/// <returns>Check results</returns>
+	Result Check(DTCLib::DTC_Event const& event, EventHeader& header);
+
+	/// <summary>
+	/// Round-robin check, shared with EventHeaderBuilder
+	/// </summary>
+	/// <param name="ewt">Event Window Tag of the event</param>
+	/// <param name="evbID">ID of the event builder which built the event</param>
+	/// <param name="nEVBs">Number of event builders in the round robin (0: the check passes)</param>
+	/// <returns>Whether the event was built by the event builder the round robin assigns to its EWT</returns>
+	static bool RoundRobinCheck(uint64_t ewt, uint8_t evbID, uint8_t nEVBs) { return nEVBs == 0 || ewt % nEVBs == evbID; }
+	/// <summary>
+	/// Number-of-DTCs check, shared with EventHeaderBuilder
+	/// </summary>
+	/// <param name="nDTCs">Number of DTCs in the event</param>
+	/// <param name="expectedDTCs">Number of DTCs expected in the event (0: the check passes)</param>
+	/// <returns>Whether the numbers match</returns>
+	static bool NDTCCheck(size_t nDTCs, size_t expectedDTCs) { return expectedDTCs == 0 || nDTCs == expectedDTCs; }
+
+	size_t GetEventCount() const { return events_; }
+	size_t GetEWTFailures() const { return ewtFailures_; }
+	size_t GetDTCFailures() const { return dtcFailures_; }
+	size_t GetNDTCFailures() const { return ndtcFailures_; }
+	size_t GetRoundRobinFailures() const { return rnrFailures_; }
+
+private:
+	using DTCMask = std::array<uint64_t, 4>;  ///< One bit per 8-bit DTC ID
+
+	Config config_;
+	DTCMask expectedMask_{};
+
+	size_t events_{0};
+	size_t ewtFailures_{0};
+	size_t dtcFailures_{0};
+	size_t ndtcFailures_{0};
+	size_t rnrFailures_{0};
+};
+
+}  // namespace mu2e
+
+#endif  // mu2e_artdaq_core_Data_EventConsistencyChecker_hh
@@ -0,0 +1,37 @@
+#include "artdaq-core-mu2e/Data/EventHeaderBuilder.hh"
+
+#include "artdaq-core-mu2e/Data/EventConsistencyChecker.hh"
+
+void mu2e::EventHeaderBuilder::Fill(DTCLib::DTC_EventHeader const* dtcHeaders, CFOLib::CFO_EventRecord const* cfoRecords, size_t n, EventHeader* out) const
+{
+	for (size_t ii = 0; ii < n; ++ii)
+	{
+		auto const& dtc = dtcHeaders[ii];
+		auto& eh = out[ii];
+
+		uint64_t ewt = dtc.event_tag_low | (static_cast<uint64_t>(dtc.event_tag_high) << 32);
+		uint64_t eventMode = dtc.event_mode;
+
+		eh.ewt = ewt;
+		eh.mode = static_cast<uint32_t>(eventMode);
+		eh.flags = static_cast<uint8_t>(eventMode >> 32);
+		eh.initErrorChecks();
+
+		if (cfoRecords != nullptr)
+		{
+			auto const& cfo = cfoRecords[ii];
+			eh.rfmTDC_est = cfo.DR_marker_N_est;
+			eh.eventDuration = cfo.event_duration;
+			eh.rfmTDC_measured = cfo.DR_marker_N_meas;
+		}
+		else
+		{
+			eh.rfmTDC_est = 0;
+			eh.eventDuration = 0;
+			eh.rfmTDC_measured = 0;
+		}
+
+		eh.rnr_check = EventConsistencyChecker::RoundRobinCheck(ewt, dtc.evb_id, config_.nEVBs);
+		eh.ndtc_check = EventConsistencyChecker::NDTCCheck(dtc.num_dtcs, config_.expectedDTCs);
+	}
+}
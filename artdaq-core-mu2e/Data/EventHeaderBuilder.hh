@@ -0,0 +1,73 @@
+#ifndef mu2e_artdaq_core_Data_EventHeaderBuilder_hh
+#define mu2e_artdaq_core_Data_EventHeaderBuilder_hh
+
+#include "artdaq-core-mu2e/Data/EventHeader.hh"
+
+#include "artdaq-core-mu2e/Overlays/CFO_Packets/CFO_EventRecord.h"
+#include "artdaq-core-mu2e/Overlays/DTC_Packets/DTC_EventHeader.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace mu2e {
+
+/// <summary>
+/// Fills mu2e::EventHeader objects from raw DTC_EventHeaders and, when available, the matching CFO_EventRecords,
+/// in one pass over arrays of headers.
+///
+/// Field mapping:
+///   ewt             = DTC_EventHeader event tag
+///   mode            = low 32 bits of the 40-bit event mode (DTC_EventMode bytes 0-3)
+///   flags           = DTC_EventMode byte 4 (bit 0: on-spill, bit 1: subrun, bit 2: predictive subrun)
+///   rfmTDC_est      = CFO_EventRecord DR_marker_N_est
+///   eventDuration   = CFO_EventRecord event_duration
+///   rfmTDC_measured = CFO_EventRecord DR_marker_N_meas
+///
+/// Check bits start from EventHeader::initErrorChecks() (1 = passed). The header-level checks are those of
+/// EventConsistencyChecker:
+///   rnr_check       cleared if the event was not built by the event builder the round robin assigns to its EWT
+///   ndtc_check      cleared if the number of DTCs differs from Config::expectedDTCs (when set)
+/// ewt_check and dtc_check need the subevents, and are left to EventConsistencyChecker::Check(event, header).
+/// </summary>
+class EventHeaderBuilder
+{
+public:
+	struct Config
+	{
+		uint8_t nEVBs{0};         ///< Number of event builders in the round robin (0: skip rnr_check)
+		uint8_t expectedDTCs{0};  ///< Number of DTCs expected in each event (0: skip ndtc_check)
+	};
+
+	EventHeaderBuilder() {}
+	explicit EventHeaderBuilder(Config const& config)
+		: config_(config) {}
+
+	/// <summary>
+	/// Fill n EventHeaders
+	/// </summary>
+	/// <param name="dtcHeaders">Array of n DTC_EventHeaders</param>
+	/// <param name="cfoRecords">Array of n matching CFO_EventRecords, or nullptr if there are none</param>
+	/// <param name="n">Number of events</param>
+	/// <param name="out">Array of n EventHeaders to fill</param>
+	void Fill(DTCLib::DTC_EventHeader const* dtcHeaders, CFOLib::CFO_EventRecord const* cfoRecords, size_t n, EventHeader* out) const;
+
+	/// <summary>
+	/// Make the EventHeader for one event
+	/// </summary>
+	/// <param name="dtcHeader">DTC_EventHeader of the event</param>
+	/// <param name="cfoRecord">Matching CFO_EventRecord, or nullptr</param>
+	/// <returns>EventHeader</returns>
+	EventHeader Make(DTCLib::DTC_EventHeader const& dtcHeader, CFOLib::CFO_EventRecord const* cfoRecord = nullptr) const
+	{
+		EventHeader out;
+		Fill(&dtcHeader, cfoRecord, 1, &out);
+		return out;
+	}
+
+private:
+	Config config_;
+};
+
+}  // namespace mu2e
+
+#endif  // mu2e_artdaq_core_Data_EventHeaderBuilder_hh
@@ -0,0 +1,368 @@
+#include "artdaq-core-mu2e/Data/EventPreselector.hh"
+
+#include "artdaq-core-mu2e/Data/CRVDataDecoder.hh"
+#include "artdaq-core-mu2e/Data/CalorimeterDataDecoder.hh"
+#include "artdaq-core-mu2e/Data/TrackerDataDecoder.hh"
+
+#include "artdaq-core-mu2e/Overlays/DTC_Packets/DTC_EventHeader.h"
+#include "artdaq-core-mu2e/Overlays/DTC_Packets/DTC_PacketViews.h"
+#include "artdaq-core-mu2e/Overlays/DTC_Packets/DTC_SubEvent.h"
+#include "artdaq-core-mu2e/Overlays/DTC_Packets/DTC_SubEventHeader.h"
+#include "artdaq-core-mu2e/Overlays/DTC_Types/DTC_EWT.h"
+
+#include "TRACE/tracemf.h"
+
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+
+namespace {
+constexpr const char* kFieldNames[mu2e::EventPreselector::FieldCount] = {
+	"event_tag",
+	"event_mode",
+	"on_spill",
+	"event_bytes",
+	"subevents",
+	"blocks",
+	"tracker.bytes",
+	"tracker.packets",
+	"calo.bytes",
+	"calo.packets",
+	"crv.bytes",
+	"crv.packets",
+	"other.bytes",
+	"other.packets",
+	"stm.bytes",
+	"stm.packets",
+	"extmon.bytes",
+	"extmon.packets",
+	"tracker.hits",
+	"calo.hits",
+	"crv.words",
+};
+
+constexpr mu2e::EventPreselector::FieldMask kHeaderFields = mu2e::EventPreselector::Bit(mu2e::EventPreselector::EventTag) |
+															  mu2e::EventPreselector::Bit(mu2e::EventPreselector::EventMode) |
+															  mu2e::EventPreselector::Bit(mu2e::EventPreselector::OnSpill) |
+															  mu2e::EventPreselector::Bit(mu2e::EventPreselector::EventBytes);
+constexpr size_t kPacketSize = 16;
+constexpr uint8_t kSubsystemCount = DTCLib::DTC_Subsystem_ExtMon + 1;
+
+// Tracker hits of a block, as TrackerDataDecoder::GetTrackerData returns them: one per block in version 0, one per
+// TrackerDataPacket and its NumADCPackets ADC packets in version 1
+uint64_t countTrackerHits(const uint8_t* payload, size_t packets, uint8_t version)
+{
+	if (packets == 0) return 0;
+	if (version == 0) return 1;
+	if (version != 1) return 0;
+
+	static_assert(sizeof(mu2e::TrackerDataDecoder::TrackerDataPacket) == kPacketSize, "TrackerDataPacket must be one packet");
+	uint64_t hits = 0;
+	size_t packet = 0;
+	while (packet < packets)
+	{
+		auto hit = reinterpret_cast<mu2e::TrackerDataDecoder::TrackerDataPacket const*>(payload + packet * kPacketSize);
+		packet += 1 + hit->NumADCPackets;
+		++hits;
+	}
+	return hits;
+}
+
+// Skip the operators' leading blanks and compare
+bool accept(std::string const& text, size_t& pos, const char* token)
+{
+	while (pos < text.size() && isspace(static_cast<unsigned char>(text[pos]))) ++pos;
+	auto length = strlen(token);
+	if (text.compare(pos, length, token) != 0) return false;
+	pos += length;
+	return true;
+}
+
+[[noreturn]] void fail(std::string const& text, size_t pos, std::string const& what)
+{
+	TLOG(TLVL_ERROR, "EventPreselector") << "Cannot compile predicate \"" << text << "\": " << what << " at position " << pos;
+	throw std::invalid_argument("EventPreselector: " + what + " at position " + std::to_string(pos) + " of \"" + text + "\"");
+}
+
+mu2e::EventPreselector::Op negate(mu2e::EventPreselector::Op op)
+{
+	using Op = mu2e::EventPreselector::Op;
+	switch (op)
+	{
+		case Op::Equal:
+			return Op::NotEqual;
+		case Op::NotEqual:
+			return Op::Equal;
+		case Op::Less:
+			return Op::GreaterEqual;
+		case Op::LessEqual:
+			return Op::Greater;
+		case Op::Greater:
+			return Op::LessEqual;
+		case Op::GreaterEqual:
+			return Op::Less;
+		case Op::AnyBits:
+			return Op::NoBits;
+		case Op::NoBits:
+			return Op::AnyBits;
+	}
+	return op;
+}
+
+// Parse one term ("[!] field [op number]") into the current group of output
+void parseTerm(std::string const& text, size_t& pos, mu2e::EventPreselector::Predicate& output)
+{
+	using Op = mu2e::EventPreselector::Op;
+	auto negated = accept(text, pos, "!");
+
+	auto begin = pos;
+	while (pos < text.size() && (isalnum(static_cast<unsigned char>(text[pos])) || text[pos] == '_' || text[pos] == '.')) ++pos;
+	if (pos == begin) fail(text, pos, "expected a field name");
+	auto name = text.substr(begin, pos - begin);
+	size_t field = 0;
+	while (field < mu2e::EventPreselector::FieldCount && name != kFieldNames[field]) ++field;
+	if (field == mu2e::EventPreselector::FieldCount) fail(text, begin, "unknown field \"" + name + "\"");
+
+	// Longer operators first; a single & must not be the start of &&
+	static const std::pair<const char*, Op> kOps[] = {
+		{"==", Op::Equal}, {"!=", Op::NotEqual}, {"<=", Op::LessEqual}, {">=", Op::GreaterEqual}, {"<", Op::Less}, {">", Op::Greater}};
+	auto op = Op::NotEqual;
+	uint64_t value = 0;
+	bool compared = false;
+	for (auto const& candidate : kOps)
+	{
+		if (accept(text, pos, candidate.first))
+		{
+			op = candidate.second;
+			compared = true;
+			break;
+		}
+	}
+	if (!compared && text.compare(pos, 2, "&&") != 0 && accept(text, pos, "&"))
+	{
+		op = Op::AnyBits;
+		compared = true;
+	}
+	if (compared)
+	{
+		while (pos < text.size() && isspace(static_cast<unsigned char>(text[pos]))) ++pos;
+		if (pos == text.size() || !isdigit(static_cast<unsigned char>(text[pos]))) fail(text, pos, "expected an unsigned number");
+		char* end = nullptr;
+		value = strtoull(text.c_str() + pos, &end, 0);
+		pos = end - text.c_str();
+	}
+
+	output.And(static_cast<mu2e::EventPreselector::Field>(field), negated ? negate(op) : op, value);
+}
+}  // namespace
+
+const char* mu2e::EventPreselector::GetFieldName(Field field)
+{
+	return field < FieldCount ? kFieldNames[field] : "unknown";
+}
+
+mu2e::EventPreselector::Predicate mu2e::EventPreselector::Predicate::Compile(std::string const& expression)
+{
+	Predicate output;
+	size_t pos = 0;
+	while (pos < expression.size() && isspace(static_cast<unsigned char>(expression[pos]))) ++pos;
+	if (pos == expression.size()) return output;
+
+	while (true)
+	{
+		parseTerm(expression, pos, output);
+		if (accept(expression, pos, "&&")) continue;
+		if (accept(expression, pos, "||"))
+		{
+			output.Or();
+			continue;
+		}
+		if (pos == expression.size()) break;
+		fail(expression, pos, "expected && or ||");
+	}
+	return output;
+}
+
+mu2e::EventPreselector::Predicate& mu2e::EventPreselector::Predicate::And(Field field, Op op, uint64_t value)
+{
+	if (!open_)
+	{
+		groupEnds_.push_back(cuts_.size());
+		open_ = true;
+	}
+	cuts_.push_back(Cut{field, op, value});
+	groupEnds_.back() = cuts_.size();
+	fields_ |= Bit(field);
+	return *this;
+}
+
+mu2e::EventPreselector::Predicate& mu2e::EventPreselector::Predicate::Or()
+{
+	open_ = false;
+	return *this;
+}
+
+std::string mu2e::EventPreselector::Predicate::ToString() const
+{
+	static const char* const kOpNames[] = {" == ", " != ", " < ", " <= ", " > ", " >= ", " & ", " & "};
+	std::string output;
+	size_t begin = 0;
+	for (auto end : groupEnds_)
+	{
+		if (begin != 0) output += " || ";
+		for (auto ii = begin; ii < end; ++ii)
+		{
+			auto const& cut = cuts_[ii];
+			if (ii != begin) output += " && ";
+			if (cut.op == Op::NoBits) output += "!";
+			output += kFieldNames[cut.field];
+			output += kOpNames[static_cast<int>(cut.op)];
+			output += std::to_string(cut.value);
+		}
+		begin = end;
+	}
+	return output;
+}
+
+bool mu2e::EventPreselector::Summarize(const void* data, size_t size, FieldMask fields, Summary& output)
+{
+	output.values.fill(0);
+	output.fields = kHeaderFields;
+	output.malformed = false;
+
+	auto ptr = static_cast<const uint8_t*>(data);
+	if (size < sizeof(DTCLib::DTC_EventHeader))
+	{
+		output.fields = 0;
+		output.malformed = true;
+		return false;
+	}
+	DTCLib::DTC_EventHeader header;
+	memcpy(&header, ptr, sizeof(header));
+	output.values[EventTag] = DTCLib::DTC_EWT(static_cast<uint32_t>(header.event_tag_low), static_cast<uint16_t>(header.event_tag_high)).value();
+	output.values[EventMode] = header.event_mode;
+	output.values[OnSpill] = (header.event_mode >> 32) & 1;
+	output.values[EventBytes] = header.inclusive_event_byte_count;
+	if ((fields & ~kHeaderFields) == 0) return true;
+	output.fields |= fields;
+
+	auto const trackerHits = (fields & Bit(TrackerHits)) != 0;
+	auto const caloHits = (fields & Bit(CaloHits)) != 0;
+	auto const crvWords = (fields & Bit(CRVWords)) != 0;
+
+	size_t end = header.inclusive_event_byte_count;
+	if (end > size)
+	{
+		output.malformed = true;
+		end = size;
+	}
+
+	// Same walk as DTC_Event::SetupEvent and DTC_SubEvent::SetupSubEvent, stopping where they would throw
+	size_t pos = sizeof(header);
+	while (pos < end && !output.malformed)
+	{
+		DTCLib::DTC_SubEventHeader subHeader;
+		if (end - pos < sizeof(subHeader))
+		{
+			output.malformed = true;
+			break;
+		}
+		memcpy(&subHeader, ptr + pos, sizeof(subHeader));
+		if (subHeader.subevent_format_version != DTCLib::DTC_SubEvent::REQUIRED_SUBEVENT_FORMAT_VERSION ||
+			subHeader.inclusive_subevent_byte_count < sizeof(subHeader))
+		{
+			output.malformed = true;
+			break;
+		}
+		++output.values[SubEvents];
+
+		size_t subEnd = pos + subHeader.inclusive_subevent_byte_count;
+		if (subEnd > end)
+		{
+			output.malformed = true;
+			subEnd = end;
+		}
+		auto blockPos = pos + sizeof(subHeader);
+		while (blockPos < subEnd)
+		{
+			DTCLib::DTC_DataHeaderView block(ptr + blockPos);
+			if (subEnd - blockPos < kPacketSize || !block.IsDataHeader() || !block.IsSizeConsistent() || blockPos + block.GetByteCount() > subEnd)
+			{
+				output.malformed = true;
+				break;
+			}
+			++output.values[Blocks];
+
+			size_t bytes = block.GetByteCount();
+			size_t packets = block.GetPacketCount();
+			auto subsystem = block.GetSubsystem();
+			if (subsystem < kSubsystemCount)
+			{
+				output.values[SubsystemBytes(subsystem)] += bytes;
+				output.values[SubsystemPackets(subsystem)] += packets;
+			}
+
+			auto payload = ptr + blockPos + kPacketSize;
+			auto payloadBytes = bytes - kPacketSize;
+			if (trackerHits && subsystem == DTCLib::DTC_Subsystem_Tracker)
+			{
+				output.values[TrackerHits] += countTrackerHits(payload, packets, block.GetVersion());
+			}
+			else if (caloHits && subsystem == DTCLib::DTC_Subsystem_Calorimeter && payloadBytes >= sizeof(CalorimeterDataDecoder::CalorimeterHitDataPacket))
+			{
+				output.values[CaloHits] += reinterpret_cast<CalorimeterDataDecoder::CalorimeterHitDataPacket const*>(payload)->NumberOfSamples;
+			}
+			else if (crvWords && subsystem == DTCLib::DTC_Subsystem_CRV && payloadBytes >= sizeof(CRVDataDecoder::CRVROCStatusPacket))
+			{
+				output.values[CRVWords] += reinterpret_cast<CRVDataDecoder::CRVROCStatusPacket const*>(payload)->ControllerEventWordCount;
+			}
+			blockPos += bytes;
+		}
+		pos += subHeader.inclusive_subevent_byte_count;
+	}
+	return !output.malformed;
+}
+
+mu2e::EventPreselector::EventPreselector(Predicate predicate)
+	: EventPreselector(std::move(predicate), Config())
+{}
+
+mu2e::EventPreselector::EventPreselector(Predicate predicate, Config const& config)
+	: predicate_(std::move(predicate)), config_(config)
+{
+	TLOG(TLVL_DEBUG, "EventPreselector") << "Selecting events with \"" << predicate_.ToString() << "\"";
+}
+
+mu2e::EventPreselector::EventPreselector(std::string const& expression)
+	: EventPreselector(Predicate::Compile(expression))
+{}
+
+bool mu2e::EventPreselector::Select(const void* data, size_t size)
+{
+	++events_;
+	auto complete = Summarize(data, size, predicate_.GetFields(), summary_);
+	bool pass;
+	if (!complete)
+	{
+		++malformed_;
+		TLOG(TLVL_DEBUG + 5, "EventPreselector") << "Event " << summary_.values[EventTag] << " is malformed or truncated after " << summary_.values[SubEvents]
+												 << " subevents, " << (config_.acceptMalformed ? "accepting" : "rejecting") << " it";
+		pass = config_.acceptMalformed;
+	}
+	else
+	{
+		pass = predicate_.Evaluate(summary_);
+	}
+	if (pass) ++accepted_;
+	return pass;
+}
+
+bool mu2e::EventPreselector::Select(DTCLib::DTC_Event const& event)
+{
+	// The header in the buffer is used, as the event's own copy is only filled by SetupEvent
+	DTCLib::DTC_EventHeader header;
+	memcpy(&header, event.GetRawBufferPointer(), sizeof(header));
+	return Select(event.GetRawBufferPointer(), header.inclusive_event_byte_count);
+}
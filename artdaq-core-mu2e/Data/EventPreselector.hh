@@ -0,0 +1,242 @@
+#ifndef mu2e_artdaq_core_Data_EventPreselector_hh
+#define mu2e_artdaq_core_Data_EventPreselector_hh
+
+#include "artdaq-core-mu2e/Overlays/DTC_Packets/DTC_Event.h"
+#include "artdaq-core-mu2e/Overlays/DTC_Types/DTC_Subsystem.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace mu2e {
+
+/// <summary>
+/// Event pre-selection on the raw DTC_Event buffer. Summarize walks only the event, subevent and ROC block headers,
+/// plus the few payload words behind the hit counts, and fills a fixed set of summary fields; a compiled Predicate
+/// is then evaluated on them. No DTC_Event, DTC_SubEvent or DTC_DataBlock objects are built and no decoder runs, so
+/// empty or off-spill events can be rejected before the full parse.
+///
+/// Predicates are written as in
+///   "!on_spill || tracker.hits >= 20 && calo.hits > 0"
+/// i.e. terms joined by && and || (&& binds tighter; there are no parentheses). A term is a field compared to an
+/// unsigned number with ==, !=, <, <=, > or >=, a field and'ed with a mask ("event_mode & 0x4", true if any bit is
+/// set), or a bare field (true if non-zero). A term may be negated with a leading '!'. The empty expression accepts
+/// every event.
+///
+/// Field names: event_tag, event_mode, on_spill, event_bytes, subevents, blocks, &lt;subsystem&gt;.bytes and
+/// &lt;subsystem&gt;.packets for subsystems tracker, calo, crv, other, stm and extmon, and tracker.hits, calo.hits
+/// and crv.words.
+/// </summary>
+class EventPreselector
+{
+public:
+	enum Field : uint8_t
+	{
+		EventTag,    ///< Event Window Tag of the event header
+		EventMode,   ///< 40-bit event mode of the event header
+		OnSpill,     ///< On-spill flag of the event mode (see DTC_EventMode::isOnSpillFlagSet)
+		EventBytes,  ///< Inclusive event byte count
+		SubEvents,   ///< Number of subevents
+		Blocks,      ///< Number of ROC blocks
+		TrackerBytes,
+		TrackerPackets,
+		CaloBytes,
+		CaloPackets,
+		CRVBytes,
+		CRVPackets,
+		OtherBytes,
+		OtherPackets,
+		STMBytes,
+		STMPackets,
+		ExtMonBytes,
+		ExtMonPackets,
+		TrackerHits,  ///< Tracker hits, following the NumADCPackets chain as TrackerDataDecoder::GetTrackerData does
+		CaloHits,     ///< Calorimeter hits, as counted by CalorimeterDataDecoder::GetCalorimeterHitData
+		CRVWords,     ///< Sum of the ControllerEventWordCount of the CRV ROC status packets
+		FieldCount
+	};
+
+	using FieldMask = uint32_t;
+	static constexpr FieldMask kAllFields = (FieldMask(1) << FieldCount) - 1;
+	static constexpr FieldMask Bit(Field field) { return FieldMask(1) << field; }
+
+	/// <summary>
+	/// Get the block byte count field of a subsystem (the packet count field follows it)
+	/// </summary>
+	static constexpr Field SubsystemBytes(DTCLib::DTC_Subsystem subsystem) { return static_cast<Field>(TrackerBytes + 2 * subsystem); }
+	static constexpr Field SubsystemPackets(DTCLib::DTC_Subsystem subsystem) { return static_cast<Field>(TrackerPackets + 2 * subsystem); }
+
+	/// <summary>
+	/// Get the name of a field, as used in predicate expressions
+	/// </summary>
+	static const char* GetFieldName(Field field);
+
+	/// <summary>
+	/// Summary fields of one event
+	/// </summary>
+	struct Summary
+	{
+		std::array<uint64_t, FieldCount> values{};
+		FieldMask fields{0};    ///< Fields filled by Summarize
+		bool malformed{false};  ///< Whether the walk stopped early on a bad header or at the end of the buffer
+
+		uint64_t Get(Field field) const { return values[field]; }
+	};
+
+	enum class Op : uint8_t
+	{
+		Equal,
+		NotEqual,
+		Less,
+		LessEqual,
+		Greater,
+		GreaterEqual,
+		AnyBits,  ///< (field & value) != 0
+		NoBits    ///< (field & value) == 0
+	};
+
+	struct Cut
+	{
+		Field field;
+		Op op;
+		uint64_t value;
+
+		bool Passes(uint64_t x) const
+		{
+			switch (op)
+			{
+				case Op::Equal:
+					return x == value;
+				case Op::NotEqual:
+					return x != value;
+				case Op::Less:
+					return x < value;
+				case Op::LessEqual:
+					return x <= value;
+				case Op::Greater:
+					return x > value;
+				case Op::GreaterEqual:
+					return x >= value;
+				case Op::AnyBits:
+					return (x & value) != 0;
+				case Op::NoBits:
+					return (x & value) == 0;
+			}
+			return false;
+		}
+	};
+
+	/// <summary>
+	/// Compiled predicate: an OR of groups of cuts which must all pass, stored as one flat array. A predicate with
+	/// no groups accepts every event.
+	/// </summary>
+	class Predicate
+	{
+	public:
+		Predicate() = default;
+
+		/// <summary>
+		/// Compile a predicate expression (see EventPreselector)
+		/// </summary>
+		/// <exception cref="std::invalid_argument">The expression cannot be parsed</exception>
+		static Predicate Compile(std::string const& expression);
+
+		/// <summary>
+		/// Add a cut to the current group (the first call opens one)
+		/// </summary>
+		Predicate& And(Field field, Op op, uint64_t value);
+		/// <summary>
+		/// Close the current group; the following cuts form an alternative to it
+		/// </summary>
+		Predicate& Or();
+
+		bool Evaluate(Summary const& summary) const
+		{
+			size_t begin = 0;
+			for (auto end : groupEnds_)
+			{
+				auto ii = begin;
+				while (ii < end && cuts_[ii].Passes(summary.values[cuts_[ii].field])) ++ii;
+				if (ii == end) return true;
+				begin = end;
+			}
+			return groupEnds_.empty();
+		}
+
+		/// <summary>
+		/// Get the fields the predicate reads, so that Summarize can skip the others
+		/// </summary>
+		FieldMask GetFields() const { return fields_; }
+		/// <summary>
+		/// Get the predicate in expression syntax
+		/// </summary>
+		std::string ToString() const;
+
+	private:
+		std::vector<Cut> cuts_;
+		std::vector<size_t> groupEnds_;  ///< End index in cuts_ of each group
+		FieldMask fields_{0};
+		bool open_{false};  ///< Whether And adds to the last group
+	};
+
+	/// <summary>
+	/// Fill the summary of the event at data. Header fields are always filled; block-level fields and the hit counts
+	/// only if requested, as they need the walk over the subevents and, for the hit counts, reads of payload words.
+	/// </summary>
+	/// <param name="data">Pointer to the DTC_EventHeader of the event</param>
+	/// <param name="size">Number of bytes available at data; the walk never reads past it</param>
+	/// <param name="fields">Fields to fill</param>
+	/// <param name="output">Summary to fill</param>
+	/// <returns>Whether the event was walked to its end</returns>
+	static bool Summarize(const void* data, size_t size, FieldMask fields, Summary& output);
+
+	struct Config
+	{
+		bool acceptMalformed{true};  ///< Accept events whose walk stopped early, so that the full decode reports them
+	};
+
+	explicit EventPreselector(Predicate predicate);
+	EventPreselector(Predicate predicate, Config const& config);
+	/// <summary>
+	/// Construct a preselector from a predicate expression
+	/// </summary>
+	/// <exception cref="std::invalid_argument">The expression cannot be parsed</exception>
+	explicit EventPreselector(std::string const& expression);
+
+	/// <summary>
+	/// Decide whether to keep the event at data
+	/// </summary>
+	/// <param name="data">Pointer to the DTC_EventHeader of the event</param>
+	/// <param name="size">Number of bytes available at data</param>
+	/// <returns>Whether the event passes the predicate</returns>
+	bool Select(const void* data, size_t size);
+	/// <summary>
+	/// Decide whether to keep an event, from its raw buffer; SetupEvent need not have been called
+	/// </summary>
+	bool Select(DTCLib::DTC_Event const& event);
+
+	/// <summary>
+	/// Get the summary of the last event passed to Select (only the fields the predicate reads are filled)
+	/// </summary>
+	Summary const& GetLastSummary() const { return summary_; }
+	Predicate const& GetPredicate() const { return predicate_; }
+
+	size_t GetEventCount() const { return events_; }
+	size_t GetAcceptedCount() const { return accepted_; }
+	size_t GetMalformedCount() const { return malformed_; }
+
+private:
+	Predicate predicate_;
+	Config config_;
+	Summary summary_;
+
+	size_t events_{0};
+	size_t accepted_{0};
+	size_t malformed_{0};
+};
+
+}  // namespace mu2e
+
+#endif  // mu2e_artdaq_core_Data_EventPreselector_hh
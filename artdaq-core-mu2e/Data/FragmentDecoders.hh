@@ -0,0 +1,100 @@
+#ifndef mu2e_artdaq_core_Data_FragmentDecoders_hh
+#define mu2e_artdaq_core_Data_FragmentDecoders_hh
+
+#include "artdaq-core-mu2e/Data/CRVDataDecoder.hh"
+#include "artdaq-core-mu2e/Data/CalorimeterDataDecoder.hh"
+#include "artdaq-core-mu2e/Data/TrackerDataDecoder.hh"
+
+#include "artdaq-core-mu2e/Overlays/DTCEventFragment.hh"
+#include "artdaq-core-mu2e/Overlays/FragmentDispatcher.hh"
+#include "artdaq-core-mu2e/Overlays/FragmentType.hh"
+#include "artdaq-core-mu2e/Overlays/STMFragment.hh"
+#include "artdaq-core-mu2e/Overlays/TrkDtcFragment.hh"
+
+#include "artdaq-core-mu2e/Overlays/DTC_Packets/DTC_SubEventHeader.h"
+
+#include "TRACE/tracemf.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+namespace mu2e {
+
+namespace detail {
+
+// Build the decoder or overlay of a Fragment: overlays wrap the Fragment, subevent decoders copy its payload
+template<typename Decoder>
+Decoder makeFragmentDecoder(artdaq::Fragment const& fragment)
+{
+	if constexpr (std::is_constructible_v<Decoder, artdaq::Fragment const&>)
+	{
+		return Decoder(fragment);
+	}
+	else
+	{
+		return Decoder(std::vector<uint8_t>(fragment.dataBeginBytes(), fragment.dataBeginBytes() + fragment.dataSizeBytes()));
+	}
+}
+
+template<typename Decoder, typename Consumer>
+void registerFragmentDecoder(FragmentDispatcher& dispatcher, FragmentType type, Consumer& consumer)
+{
+	if constexpr (std::is_invocable_v<Consumer&, Decoder const&, artdaq::Fragment const&>)
+	{
+		dispatcher.registerHandler(
+			type, [](void* context, artdaq::Fragment const* const* fragments, size_t count) {
+				auto& cons = *static_cast<Consumer*>(context);
+				for (size_t ii = 0; ii < count; ++ii)
+				{
+					auto const& fragment = *fragments[ii];
+					if constexpr (std::is_base_of_v<DTCDataDecoder, Decoder>)
+					{
+						if (fragment.dataSizeBytes() < sizeof(DTCLib::DTC_SubEventHeader))
+						{
+							TLOG(TLVL_WARNING, "FragmentDecoders") << "Skipping " << fragmentTypeName(static_cast<FragmentType>(fragment.type()))
+																   << " Fragment " << fragment.sequenceID() << " of " << fragment.dataSizeBytes()
+																   << " bytes, which is too small for a DTC subevent";
+							continue;
+						}
+					}
+					cons(makeFragmentDecoder<Decoder>(fragment), fragment);
+				}
+			},
+			&consumer);
+	}
+}
+
+}  // namespace detail
+
+/// <summary>
+/// Register the built-in decoders of the Mu2e Fragment types with a FragmentDispatcher:
+///   TRK    TrackerDataDecoder      (the Fragment payload is one DTC subevent)
+///   CAL    CalorimeterDataDecoder  (the Fragment payload is one DTC subevent)
+///   CRV    CRVDataDecoder          (the Fragment payload is one DTC subevent)
+///   DTCEVT DTCEventFragment
+///   STM    STMFragment
+///   TRKDTC TrkDtcFragment
+/// For each Fragment, the handler builds the decoder or overlay and calls consumer(decoder, fragment). A type is only
+/// registered if the consumer can be called with its decoder, so a consumer overloading operator() for, e.g.,
+/// TrackerDataDecoder const& and CalorimeterDataDecoder const& only receives TRK and CAL Fragments; the other types
+/// stay unhandled. Decoder exceptions propagate out of FragmentDispatcher::decode.
+/// </summary>
+/// <typeparam name="Consumer">Type callable with (Decoder const&, artdaq::Fragment const&) for the decoders it handles</typeparam>
+/// <param name="dispatcher">Dispatcher to register with; existing handlers of these types are replaced</param>
+/// <param name="consumer">Consumer, held by reference, so it must outlive the registration</param>
+template<typename Consumer>
+void registerFragmentDecoders(FragmentDispatcher& dispatcher, Consumer& consumer)
+{
+	detail::registerFragmentDecoder<TrackerDataDecoder>(dispatcher, FragmentType::TRK, consumer);
+	detail::registerFragmentDecoder<CalorimeterDataDecoder>(dispatcher, FragmentType::CAL, consumer);
+	detail::registerFragmentDecoder<CRVDataDecoder>(dispatcher, FragmentType::CRV, consumer);
+	detail::registerFragmentDecoder<DTCEventFragment>(dispatcher, FragmentType::DTCEVT, consumer);
+	detail::registerFragmentDecoder<STMFragment>(dispatcher, FragmentType::STM, consumer);
+	detail::registerFragmentDecoder<TrkDtcFragment>(dispatcher, FragmentType::TRKDTC, consumer);
+}
+
+}  // namespace mu2e
+
+#endif  // mu2e_artdaq_core_Data_FragmentDecoders_hh
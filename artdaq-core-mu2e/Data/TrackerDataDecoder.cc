@@ -1,5 +1,7 @@
 #include "artdaq-core-mu2e/Data/TrackerDataDecoder.hh"
 
+#include "artdaq-core-mu2e/Overlays/DTC_Types/DTC_Instrumentation.h"
+
 #include "TRACE/tracemf.h"
 
 #include <vector>
@@ -11,10 +13,10 @@ TrackerDataDecoder::TrackerDataDecoder(DTCLib::DTC_SubEvent const& evt)
 	if (block_count() > 0)
 	{
 		auto dataPtr = dataAtBlockIndex(0);
-		auto hdr = dataPtr->GetHeader();
-		if (hdr->GetSubsystem() != DTCLib::DTC_Subsystem_Tracker || hdr->GetVersion() > 1)
+		auto hdr = dataPtr->GetHeaderView();
+		if (hdr.GetSubsystem() != DTCLib::DTC_Subsystem_Tracker || hdr.GetVersion() > 1)
 		{
-			TLOG(TLVL_ERROR) << "TrackerDataDecoder CONSTRUCTOR: First block has unexpected type/version " << hdr->GetSubsystem() << "/" << static_cast<int>(hdr->GetVersion()) << " (expected " << static_cast<int>(DTCLib::DTC_Subsystem_Tracker) << "/[0,1])";
+			TLOG(TLVL_ERROR) << "TrackerDataDecoder CONSTRUCTOR: First block has unexpected type/version " << hdr.GetSubsystem() << "/" << static_cast<int>(hdr.GetVersion()) << " (expected " << static_cast<int>(DTCLib::DTC_Subsystem_Tracker) << "/[0,1])";
 		}
 	}
 }
@@ -25,10 +27,10 @@ TrackerDataDecoder::TrackerDataDecoder(std::vector<uint8_t> data)
 	if (block_count() > 0)
 	{
 		auto dataPtr = dataAtBlockIndex(0);
-		auto hdr = dataPtr->GetHeader();
-		if (hdr->GetSubsystem() != DTCLib::DTC_Subsystem_Tracker || hdr->GetVersion() > 1)
+		auto hdr = dataPtr->GetHeaderView();
+		if (hdr.GetSubsystem() != DTCLib::DTC_Subsystem_Tracker || hdr.GetVersion() > 1)
 		{
-			TLOG(TLVL_ERROR) << "TrackerDataDecoder CONSTRUCTOR: First block has unexpected type/version " << hdr->GetSubsystem() << "/" << static_cast<int>(hdr->GetVersion()) << " (expected " << static_cast<int>(DTCLib::DTC_Subsystem_Tracker) << "/[0,1])";
+			TLOG(TLVL_ERROR) << "TrackerDataDecoder CONSTRUCTOR: First block has unexpected type/version " << hdr.GetSubsystem() << "/" << static_cast<int>(hdr.GetVersion()) << " (expected " << static_cast<int>(DTCLib::DTC_Subsystem_Tracker) << "/[0,1])";
 		}
 	}
 }
@@ -39,21 +41,23 @@ TrackerDataDecoder::tracker_data_t TrackerDataDecoder::GetTrackerData(size_t blo
 
 	auto dataPtr = dataAtBlockIndex(blockIndex);
 	if (dataPtr == nullptr) return output;
-	switch (dataPtr->GetHeader()->GetVersion())
+	DTC_INSTRUMENT_SCOPE(timer, TrackerDecode);
+	switch (dataPtr->GetHeaderView().GetVersion())
 	{
 		case 0: {
+			UpgradeV0Blocks();
 			auto trackerPacket = reinterpret_cast<TrackerDataPacketV0 const*>(dataPtr->GetData());
-			output.emplace_back(Upgrade(trackerPacket), readWaveform ? GetWaveformV0(trackerPacket)
-																	 : std::vector<uint16_t>());
+			output.emplace_back(&upgraded_data_packets_[upgraded_index_[blockIndex]], readWaveform ? GetWaveformV0(trackerPacket)
+																								   : std::vector<uint16_t>());
 		}
 		break;
 		case 1: {
 			auto pos = reinterpret_cast<TrackerDataPacket const*>(dataPtr->GetData());
 			auto packetsProcessed = 0;
-			output.reserve(dataPtr->GetHeader()->GetPacketCount());
+			output.reserve(dataPtr->GetHeaderView().GetPacketCount());
 
 			// Critical Assumption: TrackerDataPacket and TrackerADCPacket are both 16 bytes!
-			while (packetsProcessed < dataPtr->GetHeader()->GetPacketCount())
+			while (packetsProcessed < dataPtr->GetHeaderView().GetPacketCount())
 			{
 				output.emplace_back(pos, readWaveform ? GetWaveform(pos) : std::vector<uint16_t>());
 				auto nPackets = 1 + pos->NumADCPackets;  // TrackerDataPacket + NumADCPackets
@@ -64,6 +68,7 @@ TrackerDataDecoder::tracker_data_t TrackerDataDecoder::GetTrackerData(size_t blo
 		}
 	}
 
+	DTC_INSTRUMENT_ADD(timer, dataPtr->byteSize, output.size());
 	return output;
 }
 
@@ -124,12 +129,25 @@ std::vector<uint16_t> TrackerDataDecoder::GetWaveform(TrackerDataPacket const* t
 	return output;
 }
 
-const TrackerDataDecoder::TrackerDataPacket* TrackerDataDecoder::Upgrade(const TrackerDataDecoder::TrackerDataPacketV0* input) const
+void TrackerDataDecoder::UpgradeV0Blocks() const
 {
-	if (input == nullptr) return nullptr;
+	upgraded_.call([this] {
+		upgraded_data_packets_.clear();
+		upgraded_index_.assign(block_count(), 0);
+		for (size_t ii = 0; ii < block_count(); ++ii)
+		{
+			auto dataPtr = dataAtBlockIndex(ii);
+			if (dataPtr->GetHeaderView().GetVersion() != 0) continue;
+			upgraded_index_[ii] = upgraded_data_packets_.size();
+			upgraded_data_packets_.push_back(Upgrade(reinterpret_cast<TrackerDataPacketV0 const*>(dataPtr->GetData())));
+		}
+	});
+}
 
-	upgraded_data_packets_.emplace_back();
-	TrackerDataPacket* output = &upgraded_data_packets_.back();
+TrackerDataDecoder::TrackerDataPacket TrackerDataDecoder::Upgrade(const TrackerDataDecoder::TrackerDataPacketV0* input) const
+{
+	TrackerDataPacket packet{};
+	TrackerDataPacket* output = &packet;
 	output->StrawIndex = input->StrawIndex;
 
 	output->TDC0A = input->TDC0;
@@ -147,6 +165,6 @@ const TrackerDataDecoder::TrackerDataPacket* TrackerDataDecoder::Upgrade(const T
 	output->NumADCPackets = 1;
 	output->PMP = 0;
 
-	return output;
+	return packet;
 }
 }  // namespace mu2e
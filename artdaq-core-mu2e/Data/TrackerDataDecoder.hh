@@ -283,14 +283,23 @@ public:
 
 	typedef std::vector<std::pair<const TrackerDataPacket*, std::vector<uint16_t>>> tracker_data_t;
 	tracker_data_t GetTrackerData(size_t blockIndex, bool readWaveform = true) const;
-	void ClearUpgradedPackets() { upgraded_data_packets_.clear(); }
+	void ClearUpgradedPackets()
+	{
+		upgraded_data_packets_.clear();
+		upgraded_index_.clear();
+		upgraded_.reset();
+	}
 
 private:
-	const TrackerDataPacket* Upgrade(const TrackerDataPacketV0* input) const;
+	TrackerDataPacket Upgrade(const TrackerDataPacketV0* input) const;
+	void UpgradeV0Blocks() const;
 	std::vector<uint16_t> GetWaveformV0(const TrackerDataPacketV0* input) const;
 	std::vector<uint16_t> GetWaveform(const TrackerDataPacket* input) const;
 
-	mutable std::vector<TrackerDataPacket> upgraded_data_packets_;
+	// Format version 0 packets are converted once, for all blocks, so that GetTrackerData does not modify the decoder
+	DecoderSetupFlag upgraded_;                                      //! transient
+	mutable std::vector<TrackerDataPacket> upgraded_data_packets_;  //! transient, only written under upgraded_
+	mutable std::vector<size_t> upgraded_index_;                     //! transient, index in upgraded_data_packets_ of each block
 
 };
 }  // namespace mu2e
@@ -7,6 +7,7 @@
 #include "artdaq-core-mu2e/Data/TrackerDataDecoder.hh"
 #include "artdaq-core-mu2e/Data/CalorimeterDataDecoder.hh"
 #include "artdaq-core-mu2e/Data/CRVDataDecoder.hh"
+#include "artdaq-core-mu2e/Data/CompactDTCData.hh"
 #include <vector>
 #include "canvas/Persistency/Common/Wrapper.h"
 
@@ -1,6 +1,8 @@
 #ifndef artdaq_core_mu2e_Overlays_CFO_Packets_CFO_EventRecord_h
 #define artdaq_core_mu2e_Overlays_CFO_Packets_CFO_EventRecord_h
 
+#include "artdaq-core-mu2e/Overlays/DTC_Types/DTC_JSONWriter.h"
+
 #include <cstdint>  // uint8_t, uint16_t
 #include <iomanip>
 #include <sstream>
@@ -61,23 +63,31 @@ struct CFO_EventRecord
 
 	inline std::string toJson() const
 	{
-		std::ostringstream oss;
-
-		oss << "\"CFO_EventRecord\": {\n";
-		oss << "\t\"record_format_version\": 0x" <<  std::hex << record_format_version << std::dec;
-		oss << ",\n\t\"event_tag\": " << event_tag << "(0x" <<  std::hex << event_tag << std::dec << ")";
-		oss << ",\n\t\"linux_timestamp\": " << linux_timestamp;
-		oss << ",\n\t\"event_mode\": 0x" << std::hex << event_mode << std::dec;
-		oss << ",\n\t\"event_duration\": " << event_duration;
-		oss << ",\n\t\"TDC_marker_N_from_spill\": " << TDC_marker_N_from_spill;
-		oss << ",\n\t\"DR_marker_N_est\": " << DR_marker_N_est;
-		oss << ",\n\t\"DR_marker_Nplus1_est\": " << DR_marker_Nplus1_est;
-		oss << ",\n\t\"DR_marker_N_meas\": " << DR_marker_N_meas;
-		oss << ",\n\t\"DR_marker_Nplus1_meas\": " << DR_marker_Nplus1_meas;
-		oss << "\n}";
-
-		return oss.str();
-	} //end toJson()
+		std::string output;
+		AppendJson(output);
+		return output;
+	}
+
+	/// <summary>
+	/// Append the JSON representation (see toJson()) to a string
+	/// </summary>
+	/// <param name="output">String to append to</param>
+	inline void AppendJson(std::string& output) const
+	{
+		DTCLib::DTC_JSONWriter writer(output);
+		writer.BeginObject("CFO_EventRecord");
+		writer.HexField("record_format_version", record_format_version);
+		writer.Key("event_tag").Dec(event_tag).Raw("(").PrefixedHex(event_tag).Raw(")");
+		writer.Field("linux_timestamp", linux_timestamp);
+		writer.HexField("event_mode", event_mode);
+		writer.Field("event_duration", event_duration);
+		writer.Field("TDC_marker_N_from_spill", TDC_marker_N_from_spill);
+		writer.Field("DR_marker_N_est", DR_marker_N_est);
+		writer.Field("DR_marker_Nplus1_est", DR_marker_Nplus1_est);
+		writer.Field("DR_marker_N_meas", DR_marker_N_meas);
+		writer.Field("DR_marker_Nplus1_meas", DR_marker_Nplus1_meas);
+		writer.EndObject();
+	} //end AppendJson()
 };
 
 }  // namespace CFOLib
@@ -6,11 +6,21 @@
 #include "artdaq-core-mu2e/Overlays/DTC_Packets/DTC_DataRequestPacket.h"
 #include "artdaq-core-mu2e/Overlays/DTC_Packets/DTC_DataStatus.h"
 #include "artdaq-core-mu2e/Overlays/DTC_Packets/DTC_DCSReplyPacket.h"
+#include "artdaq-core-mu2e/Overlays/DTC_Packets/DTC_DCSReplyView.h"
+#include "artdaq-core-mu2e/Overlays/DTC_Packets/DTC_DCSRequestEncoder.h"
 #include "artdaq-core-mu2e/Overlays/DTC_Packets/DTC_DCSRequestPacket.h"
 #include "artdaq-core-mu2e/Overlays/DTC_Packets/DTC_DMAPacket.h"
 #include "artdaq-core-mu2e/Overlays/DTC_Packets/DTC_Event.h"
 #include "artdaq-core-mu2e/Overlays/DTC_Packets/DTC_EventHeader.h"
+#include "artdaq-core-mu2e/Overlays/DTC_Packets/DTC_EventMerger.h"
+#include "artdaq-core-mu2e/Overlays/DTC_Packets/DTC_EventPipeline.h"
+#include "artdaq-core-mu2e/Overlays/DTC_Packets/DTC_EventQueue.h"
+#include "artdaq-core-mu2e/Overlays/DTC_Packets/DTC_EventSkimmer.h"
 #include "artdaq-core-mu2e/Overlays/DTC_Packets/DTC_HeartbeatPacket.h"
+#include "artdaq-core-mu2e/Overlays/DTC_Packets/DTC_LatencyMonitor.h"
+#include "artdaq-core-mu2e/Overlays/DTC_Packets/DTC_LinkStatistics.h"
+#include "artdaq-core-mu2e/Overlays/DTC_Packets/DTC_PacketClassifier.h"
 #include "artdaq-core-mu2e/Overlays/DTC_Packets/DTC_PacketType.h"
+#include "artdaq-core-mu2e/Overlays/DTC_Packets/DTC_PacketViews.h"
 #include "artdaq-core-mu2e/Overlays/DTC_Packets/DTC_SubEvent.h"
 #include "artdaq-core-mu2e/Overlays/DTC_Packets/DTC_SubEventHeader.h"
\ No newline at end of file
@@ -69,6 +69,7 @@ DTCLib::DTC_DCSReplyPacket::DTC_DCSReplyPacket(DTC_DataPacket in)
 	{
 		address2_ = 0;
 		data2_ = 0;
+		blockReadData_.reserve(3 + (in.GetSize() > 16 ? (in.GetSize() - 16) / 2 : 0));
 		if (data1_ > 0)
 		{
 			blockReadData_.push_back(in.GetData()[10] + (in.GetData()[11] << 8));
@@ -0,0 +1,52 @@
+#include "artdaq-core-mu2e/Overlays/DTC_Packets/DTC_DCSReplyView.h"
+
+#include "TRACE/tracemf.h"
+
+#include <algorithm>
+
+DTCLib::DTC_DCSReplyView::WordRange DTCLib::DTC_DCSReplyView::GetBlockReadData() const
+{
+	WordRange output;
+	if (!IsDCSReply() || GetType() != DTC_DCSOperationType_BlockRead) return output;
+
+	// Block Read words start at byte 10 of the reply packet and continue through the payload packets
+	size_t available = (std::min(size_, GetSizeBytes()) - 10) / sizeof(uint16_t);
+	output.data = reinterpret_cast<const uint16_t*>(data_ + 10);
+	output.size = std::min<size_t>(word(8), available);
+	return output;
+}
+
+size_t DTCLib::DTC_DCSReplyView::ParseReplies(const void* buffer, size_t size, std::vector<DTC_DCSReplyView>& replies)
+{
+	auto ptr = static_cast<const uint8_t*>(buffer);
+	size_t offset = 0;
+	while (offset + 16 <= size)
+	{
+		DTC_DCSReplyView reply(ptr + offset, size - offset);
+		if (!reply.IsDCSReply())
+		{
+			// Skip the whole DMA packet, including any payload packets (e.g. of a Data Header), by its byte count
+			// rounded up to whole 16-byte packets
+			size_t skip = ((ptr[offset] + (ptr[offset + 1] << 8)) + 15) & ~size_t(15);
+			if (skip == 0 || offset + skip > size)
+			{
+				TLOG(TLVL_WARNING, "DTC_DCSReplyView") << "Packet of type " << static_cast<int>(ptr[offset + 2] >> 4) << " at offset " << offset << " has byte count " << skip
+													   << ", which does not fit in the " << (size - offset) << " bytes remaining in the buffer";
+				break;
+			}
+			TLOG(TLVL_DEBUG + 5, "DTC_DCSReplyView") << "Skipping packet of type " << static_cast<int>(ptr[offset + 2] >> 4) << " and " << skip << " bytes at offset " << offset;
+			offset += skip;
+			continue;
+		}
+		if (!reply.IsComplete())
+		{
+			TLOG(TLVL_WARNING, "DTC_DCSReplyView") << "DCS Reply at offset " << offset << " announces " << reply.GetBlockPacketCount()
+												   << " Block Read packets, but only " << (size - offset) << " bytes remain in the buffer";
+			break;
+		}
+		reply.size_ = reply.GetSizeBytes();
+		replies.push_back(reply);
+		offset += reply.size_;
+	}
+	return offset;
+}
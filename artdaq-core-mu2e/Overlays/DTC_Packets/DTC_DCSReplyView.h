@@ -0,0 +1,165 @@
+#ifndef artdaq_core_mu2e_Overlays_DTC_Packets_DTC_DCSReplyView_h
+#define artdaq_core_mu2e_Overlays_DTC_Packets_DTC_DCSReplyView_h
+
+#include "artdaq-core-mu2e/Overlays/DTC_Packets/DTC_PacketType.h"
+
+#include "artdaq-core-mu2e/Overlays/DTC_Types/DTC_DCSOperationType.h"
+#include "artdaq-core-mu2e/Overlays/DTC_Types/DTC_Link_ID.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>  // std::pair
+#include <vector>
+
+namespace DTCLib {
+
+/// <summary>
+/// Read-only overlay of a DCS Reply packet (and any Block Read payload packets following it) in place in a DMA buffer.
+/// Unlike DTC_DCSReplyPacket, no fields are decoded up front and the Block Read payload is not copied.
+/// The buffer must outlive the view. Multi-byte fields are little-endian, as on the DTC.
+/// </summary>
+class DTC_DCSReplyView
+{
+public:
+	/// <summary>
+	/// Range of 16-bit Block Read words, in place in the DMA buffer
+	/// </summary>
+	struct WordRange
+	{
+		const uint16_t* data{nullptr};  ///< First word
+		size_t size{0};                 ///< Number of words
+
+		const uint16_t* begin() const { return data; }
+		const uint16_t* end() const { return data + size; }
+		bool empty() const { return size == 0; }
+		uint16_t operator[](size_t idx) const { return data[idx]; }
+	};
+
+	/// <summary>
+	/// Construct an empty (invalid) view
+	/// </summary>
+	DTC_DCSReplyView() {}
+
+	/// <summary>
+	/// Overlay a DTC_DCSReplyView on the given memory. The packet type is not checked; use IsDCSReply().
+	/// </summary>
+	/// <param name="data">Pointer to the first byte of the DCS Reply packet. Must be 2-byte aligned.</param>
+	/// <param name="size">Number of bytes available at data</param>
+	DTC_DCSReplyView(const void* data, size_t size)
+		: data_(static_cast<const uint8_t*>(data)), size_(size) {}
+
+	/// <summary>
+	/// Whether the view covers at least one full packet of type DCS Reply
+	/// </summary>
+	bool IsDCSReply() const { return data_ != nullptr && size_ >= 16 && static_cast<DTC_PacketType>(data_[2] >> 4) == DTC_PacketType_DCSReply; }
+
+	/// <summary>
+	/// Whether the Block Read payload packets announced by the reply are all within the view
+	/// </summary>
+	bool IsComplete() const { return IsDCSReply() && GetSizeBytes() <= size_; }
+
+	/// <summary>
+	/// Get the number of bytes occupied by this reply, including Block Read payload packets
+	/// </summary>
+	size_t GetSizeBytes() const { return 16 * (1 + static_cast<size_t>(GetBlockPacketCount())); }
+
+	/// <summary>
+	/// Get the pointer to the first byte of the reply
+	/// </summary>
+	const uint8_t* GetData() const { return data_; }
+
+	/// <summary>
+	/// Get the block byte count from the DMA header
+	/// </summary>
+	uint16_t GetByteCount() const { return word(0); }
+	/// <summary>
+	/// Get the valid bit from the DMA header
+	/// </summary>
+	bool isValid() const { return (data_[3] & 0x80) == 0x80; }
+	/// <summary>
+	/// Get the Link ID of the packet
+	/// </summary>
+	DTC_Link_ID GetLinkID() const { return static_cast<DTC_Link_ID>(data_[3] & 0x7); }
+	/// <summary>
+	/// Get the hop count of the packet
+	/// </summary>
+	uint8_t GetHopCount() const { return data_[2] & 0xF; }
+	/// <summary>
+	/// Get the DTC error bits
+	/// </summary>
+	uint8_t GetDTCErrorBits() const { return (data_[3] >> 3) & 0xF; }
+
+	/// <summary>
+	/// Get the DCS Operation Type, decoded as in DTC_DCSReplyPacket
+	/// </summary>
+	DTC_DCSOperationType GetType() const
+	{
+		uint8_t tmpType = data_[4] & 0xF;
+		if (tmpType != DTC_DCSOperationType_InvalidS2C && tmpType != DTC_DCSOperationType_Timeout) tmpType &= 0x3;
+		return static_cast<DTC_DCSOperationType>(tmpType);
+	}
+	/// <summary>
+	/// Read the double operation bit
+	/// </summary>
+	bool IsDoubleOperation() const { return (data_[4] & 0x4) == 0x4; }
+	/// <summary>
+	/// Read the "request acknowledgment" bit
+	/// </summary>
+	bool IsAckRequested() const { return (data_[4] & 0x8) == 0x8; }
+	/// <summary>
+	/// Read the DCS Receive FIFO Empty flag
+	/// </summary>
+	bool DCSReceiveFIFOEmpty() const { return (data_[4] & 0x10) == 0x10; }
+	/// <summary>
+	/// Read the ROC corrupt flag
+	/// </summary>
+	bool ROCIsCorrupt() const { return (data_[4] & 0x20) == 0x20; }
+	/// <summary>
+	/// Get the number of Block Read payload packets following the reply packet
+	/// </summary>
+	uint16_t GetBlockPacketCount() const { return (data_[4] >> 6) + (data_[5] << 2); }
+
+	/// <summary>
+	/// Get the reply address/data pair
+	/// </summary>
+	/// <param name="secondOp">Whether to read the second operation (always 0,0 for Block Read)</param>
+	/// <returns>Pair of address, data from the reply packet</returns>
+	std::pair<uint16_t, uint16_t> GetReply(bool secondOp = false) const
+	{
+		if (!secondOp) return std::make_pair(word(6), word(8));
+		if (GetType() == DTC_DCSOperationType_BlockRead) return std::make_pair(0, 0);
+		return std::make_pair(word(10), word(12));
+	}
+
+	/// <summary>
+	/// Get the Block Read word count announced by the reply
+	/// </summary>
+	uint16_t GetBlockWordCount() const { return GetType() == DTC_DCSOperationType_BlockRead ? word(8) : 0; }
+
+	/// <summary>
+	/// Get the Block Read payload, in place. The range is limited to the words actually present in the view.
+	/// </summary>
+	/// <returns>WordRange over the payload words (empty if this is not a Block Read reply)</returns>
+	WordRange GetBlockReadData() const;
+
+	/// <summary>
+	/// Overlay views on a sequence of packets in one DMA buffer. Packets which are not DCS Replies are skipped
+	/// together with their payload packets, by their DMA byte count; parsing stops at a packet whose byte count is 0
+	/// or runs past the buffer, and at the first reply whose Block Read payload does not fit in the buffer.
+	/// </summary>
+	/// <param name="buffer">Pointer to the first packet (after any DMA transfer byte count)</param>
+	/// <param name="size">Number of bytes available in buffer</param>
+	/// <param name="replies">Views are appended to this vector</param>
+	/// <returns>Number of bytes consumed</returns>
+	static size_t ParseReplies(const void* buffer, size_t size, std::vector<DTC_DCSReplyView>& replies);
+
+private:
+	uint16_t word(size_t byte) const { return data_[byte] + (data_[byte + 1] << 8); }
+
+	const uint8_t* data_{nullptr};
+	size_t size_{0};
+};
+
+}  // namespace DTCLib
+
+#endif  // artdaq_core_mu2e_Overlays_DTC_Packets_DTC_DCSReplyView_h
@@ -0,0 +1,108 @@
+#include "artdaq-core-mu2e/Overlays/DTC_Packets/DTC_DCSRequestEncoder.h"
+
+#include "artdaq-core-mu2e/Overlays/DTC_Packets/DTC_PacketType.h"
+#include "artdaq-core-mu2e/Overlays/DTC_Types/Exceptions.h"
+
+#include "TRACE/tracemf.h"
+
+#include <cstring>
+#include <string>
+
+DTCLib::DTC_DCSRequestEncoder::DTC_DCSRequestEncoder(void* buffer, size_t capacity)
+	: buffer_(static_cast<uint8_t*>(buffer)), capacity_(capacity)
+{
+	if (reinterpret_cast<uintptr_t>(buffer) % 16 != 0)
+	{
+		auto ex = DTC_IOErrorException("DCS request buffer is not 16-byte aligned");
+		TLOG(TLVL_ERROR) << ex.what();
+		throw ex;
+	}
+}
+
+// Packet layout as in DTC_DCSRequestPacket::ConvertToDataPacket; the whole first packet is written, so that
+// the buffer never has to be cleared beforehand
+uint8_t* DTCLib::DTC_DCSRequestEncoder::WriteHeader(DTC_Link_ID link, DTC_DCSOperationType type, uint16_t packetCount, bool requestAck,
+													bool incrementAddress, uint16_t address1, uint16_t data1)
+{
+	auto packet = buffer_ + byteCount_;
+	uint16_t packetByteCount = (packetCount + 1) * 16;
+
+	packet[0] = static_cast<uint8_t>(packetByteCount & 0xFF);
+	packet[1] = static_cast<uint8_t>(packetByteCount >> 8);
+	packet[2] = static_cast<uint8_t>(DTC_PacketType_DCSRequest << 4);  // Hop count 0
+	packet[3] = static_cast<uint8_t>((link & 0x7) | 0x80);             // Valid, subsystem 0
+	packet[4] = static_cast<uint8_t>(((packetCount & 0x3) << 6) + (incrementAddress ? 0x10 : 0) + (requestAck ? 0x8 : 0) + (type & 0x7));
+	packet[5] = static_cast<uint8_t>((packetCount & 0x3FC) >> 2);
+	packet[6] = static_cast<uint8_t>(address1 & 0xFF);
+	packet[7] = static_cast<uint8_t>(address1 >> 8);
+	packet[8] = static_cast<uint8_t>(data1 & 0xFF);
+	packet[9] = static_cast<uint8_t>(data1 >> 8);
+	memset(packet + 10, 0, 6);
+
+	byteCount_ += packetByteCount;
+	++requestCount_;
+	return packet;
+}
+
+bool DTCLib::DTC_DCSRequestEncoder::AddRead(DTC_Link_ID link, uint16_t address, bool requestAck)
+{
+	if (GetRemainingBytes() < 16) return false;
+	WriteHeader(link, DTC_DCSOperationType_Read, 0, requestAck, false, address, 0);
+	return true;
+}
+
+bool DTCLib::DTC_DCSRequestEncoder::AddWrite(DTC_Link_ID link, uint16_t address, uint16_t data, bool requestAck)
+{
+	if (GetRemainingBytes() < 16) return false;
+	WriteHeader(link, DTC_DCSOperationType_Write, 0, requestAck, false, address, data);
+	return true;
+}
+
+bool DTCLib::DTC_DCSRequestEncoder::AddDoubleRead(DTC_Link_ID link, uint16_t address1, uint16_t address2, bool requestAck)
+{
+	if (GetRemainingBytes() < 16) return false;
+	auto type = address2 == 0 ? DTC_DCSOperationType_Read : DTC_DCSOperationType_DoubleRead;
+	auto packet = WriteHeader(link, type, 0, requestAck, false, address1, 0);
+	packet[10] = static_cast<uint8_t>(address2 & 0xFF);
+	packet[11] = static_cast<uint8_t>(address2 >> 8);
+	return true;
+}
+
+bool DTCLib::DTC_DCSRequestEncoder::AddDoubleWrite(DTC_Link_ID link, uint16_t address1, uint16_t data1, uint16_t address2, uint16_t data2, bool requestAck)
+{
+	if (GetRemainingBytes() < 16) return false;
+	auto type = address2 == 0 && data2 == 0 ? DTC_DCSOperationType_Write : DTC_DCSOperationType_DoubleWrite;
+	auto packet = WriteHeader(link, type, 0, requestAck, false, address1, data1);
+	packet[10] = static_cast<uint8_t>(address2 & 0xFF);
+	packet[11] = static_cast<uint8_t>(address2 >> 8);
+	packet[12] = static_cast<uint8_t>(data2 & 0xFF);
+	packet[13] = static_cast<uint8_t>(data2 >> 8);
+	return true;
+}
+
+bool DTCLib::DTC_DCSRequestEncoder::AddBlockRead(DTC_Link_ID link, uint16_t address, uint16_t wordCount, bool incrementAddress, bool requestAck)
+{
+	if (GetRemainingBytes() < 16) return false;
+	WriteHeader(link, DTC_DCSOperationType_BlockRead, 0, requestAck, incrementAddress, address, wordCount);
+	return true;
+}
+
+bool DTCLib::DTC_DCSRequestEncoder::AddBlockWrite(DTC_Link_ID link, uint16_t address, const uint16_t* data, size_t wordCount, bool incrementAddress, bool requestAck)
+{
+	if (BlockWritePacketCount(wordCount) > 0x3FF)
+	{
+		auto ex = DTC_IOErrorException("Block Write of " + std::to_string(wordCount) + " words does not fit in the 10-bit packet count");
+		TLOG(TLVL_ERROR) << ex.what();
+		throw ex;
+	}
+	auto sizeBytes = BlockWriteSizeBytes(wordCount);
+	if (GetRemainingBytes() < sizeBytes) return false;
+
+	auto packet = WriteHeader(link, DTC_DCSOperationType_BlockWrite, BlockWritePacketCount(wordCount), requestAck, incrementAddress, address, wordCount);
+
+	// Payload words are little-endian, starting at byte 10 and continuing through the additional packets
+	memcpy(packet + 10, data, wordCount * sizeof(uint16_t));
+	auto payloadEnd = 10 + wordCount * sizeof(uint16_t);
+	if (payloadEnd < sizeBytes) memset(packet + payloadEnd, 0, sizeBytes - payloadEnd);
+	return true;
+}
@@ -0,0 +1,129 @@
+#ifndef artdaq_core_mu2e_Overlays_DTC_Packets_DTC_DCSRequestEncoder_h
+#define artdaq_core_mu2e_Overlays_DTC_Packets_DTC_DCSRequestEncoder_h
+
+#include "artdaq-core-mu2e/Overlays/DTC_Types/DTC_DCSOperationType.h"
+#include "artdaq-core-mu2e/Overlays/DTC_Types/DTC_Link_ID.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace DTCLib {
+
+/// <summary>
+/// Encodes DCS Request packets back to back into a caller-provided DMA buffer, producing the same bytes as
+/// DTC_DCSRequestPacket::ConvertToDataPacket() without constructing intermediate packet objects.
+/// Each Add method returns false, leaving the buffer unchanged, if the request does not fit in the remaining space;
+/// the caller should then submit GetByteCount() bytes, call Reset() and retry.
+/// </summary>
+class DTC_DCSRequestEncoder
+{
+public:
+	/// <summary>
+	/// Construct a DTC_DCSRequestEncoder
+	/// </summary>
+	/// <param name="buffer">DMA buffer to write to. Must be 16-byte aligned (throws DTC_IOErrorException otherwise)</param>
+	/// <param name="capacity">Size of the buffer, in bytes</param>
+	DTC_DCSRequestEncoder(void* buffer, size_t capacity);
+
+	/// <summary>
+	/// Add a single Read request
+	/// </summary>
+	/// <param name="link">Link of the ROC</param>
+	/// <param name="address">Register address</param>
+	/// <param name="requestAck">Whether the ROC should acknowledge the request</param>
+	/// <returns>True if the request was written</returns>
+	bool AddRead(DTC_Link_ID link, uint16_t address, bool requestAck = false);
+	/// <summary>
+	/// Add a single Write request
+	/// </summary>
+	/// <param name="link">Link of the ROC</param>
+	/// <param name="address">Register address</param>
+	/// <param name="data">Value to write</param>
+	/// <param name="requestAck">Whether the ROC should acknowledge the request</param>
+	/// <returns>True if the request was written</returns>
+	bool AddWrite(DTC_Link_ID link, uint16_t address, uint16_t data, bool requestAck = false);
+	/// <summary>
+	/// Add a Double Read request. As in DTC_DCSRequestPacket::ConvertToDataPacket, it is sent as a single Read if
+	/// address2 is 0.
+	/// </summary>
+	/// <param name="link">Link of the ROC</param>
+	/// <param name="address1">First register address</param>
+	/// <param name="address2">Second register address</param>
+	/// <param name="requestAck">Whether the ROC should acknowledge the request</param>
+	/// <returns>True if the request was written</returns>
+	bool AddDoubleRead(DTC_Link_ID link, uint16_t address1, uint16_t address2, bool requestAck = false);
+	/// <summary>
+	/// Add a Double Write request. As in DTC_DCSRequestPacket::ConvertToDataPacket, it is sent as a single Write if
+	/// address2 and data2 are both 0.
+	/// </summary>
+	/// <param name="link">Link of the ROC</param>
+	/// <param name="address1">First register address</param>
+	/// <param name="data1">Value to write to address1</param>
+	/// <param name="address2">Second register address</param>
+	/// <param name="data2">Value to write to address2</param>
+	/// <param name="requestAck">Whether the ROC should acknowledge the request</param>
+	/// <returns>True if the request was written</returns>
+	bool AddDoubleWrite(DTC_Link_ID link, uint16_t address1, uint16_t data1, uint16_t address2, uint16_t data2, bool requestAck = false);
+	/// <summary>
+	/// Add a Block Read request
+	/// </summary>
+	/// <param name="link">Link of the ROC</param>
+	/// <param name="address">First register address</param>
+	/// <param name="wordCount">Number of words to read</param>
+	/// <param name="incrementAddress">Whether the ROC should increment the address for each word</param>
+	/// <param name="requestAck">Whether the ROC should acknowledge the request</param>
+	/// <returns>True if the request was written</returns>
+	bool AddBlockRead(DTC_Link_ID link, uint16_t address, uint16_t wordCount, bool incrementAddress = false, bool requestAck = false);
+	/// <summary>
+	/// Add a Block Write request, with its additional payload packets
+	/// </summary>
+	/// <param name="link">Link of the ROC</param>
+	/// <param name="address">First register address</param>
+	/// <param name="data">Words to write</param>
+	/// <param name="wordCount">Number of words to write (at most 8187, the 10-bit packet count limit; throws DTC_IOErrorException otherwise)</param>
+	/// <param name="incrementAddress">Whether the ROC should increment the address for each word</param>
+	/// <param name="requestAck">Whether the ROC should acknowledge the request</param>
+	/// <returns>True if the request was written</returns>
+	bool AddBlockWrite(DTC_Link_ID link, uint16_t address, const uint16_t* data, size_t wordCount, bool incrementAddress = false, bool requestAck = false);
+
+	/// <summary>
+	/// Get the number of bytes written so far; always a multiple of 16
+	/// </summary>
+	size_t GetByteCount() const { return byteCount_; }
+	/// <summary>
+	/// Get the number of requests written so far
+	/// </summary>
+	size_t GetRequestCount() const { return requestCount_; }
+	/// <summary>
+	/// Get the number of bytes still available in the buffer
+	/// </summary>
+	size_t GetRemainingBytes() const { return capacity_ - byteCount_; }
+	/// <summary>
+	/// Start over at the beginning of the buffer
+	/// </summary>
+	void Reset()
+	{
+		byteCount_ = 0;
+		requestCount_ = 0;
+	}
+
+	/// <summary>
+	/// Get the number of bytes a Block Write of the given number of words occupies
+	/// </summary>
+	static size_t BlockWriteSizeBytes(size_t wordCount) { return 16 * (1 + BlockWritePacketCount(wordCount)); }
+
+private:
+	static size_t BlockWritePacketCount(size_t wordCount) { return wordCount > 3 ? (wordCount - 3 + 7) / 8 : 0; }
+
+	uint8_t* WriteHeader(DTC_Link_ID link, DTC_DCSOperationType type, uint16_t packetCount, bool requestAck, bool incrementAddress,
+						 uint16_t address1, uint16_t data1);
+
+	uint8_t* buffer_;
+	size_t capacity_;
+	size_t byteCount_{0};
+	size_t requestCount_{0};
+};
+
+}  // namespace DTCLib
+
+#endif  // artdaq_core_mu2e_Overlays_DTC_Packets_DTC_DCSRequestEncoder_h
@@ -2,8 +2,6 @@
 
 #include "TRACE/trace.h"
 
-#include <iomanip>
-#include <sstream>
 
 DTCLib::DTC_DMAPacket::DTC_DMAPacket(DTC_PacketType type, DTC_Link_ID link, uint16_t byteCount, bool valid, uint8_t subsystemID, uint8_t hopCount)
 	: byteCount_(byteCount), valid_(valid), subsystemID_(subsystemID), linkID_(link), packetType_(type), hopCount_(hopCount) {}
@@ -55,37 +53,50 @@ DTCLib::DTC_DMAPacket::DTC_DMAPacket(const DTC_DataPacket in)
 
 std::string DTCLib::DTC_DMAPacket::headerJSON() const
 {
-	std::stringstream ss;
-	ss << "\t\"byteCount\": " << std::hex << "0x" << static_cast<int>(byteCount_);
-	ss << ",\n\t\"isValid\": " << valid_;
-	ss << ",\n\t\"subsystemID\": " << std::hex << "0x" << static_cast<int>(subsystemID_);
-	ss << ",\n\t\"linkID\": " << std::dec << linkID_;
-	ss << ",\n\t\"packetType\": " << static_cast<int>(packetType_);
-	ss << ",\n\t\"hopCount\": " << std::hex << "0x" << static_cast<int>(hopCount_);
-
-	return ss.str();
+	std::string output;
+	DTC_JSONWriter writer(output);
+	AppendHeaderJSON(writer);
+	return output;
+}
+
+void DTCLib::DTC_DMAPacket::AppendHeaderJSON(DTC_JSONWriter& writer) const
+{
+	writer.HexField("byteCount", byteCount_);
+	writer.Field("isValid", valid_);
+	writer.HexField("subsystemID", subsystemID_);
+	writer.Field("linkID", linkID_);
+	writer.Field("packetType", packetType_);
+	writer.HexField("hopCount", hopCount_);
 }
 
 std::string DTCLib::DTC_DMAPacket::headerPacketFormat() const
 {
-	std::stringstream ss;
-	ss << std::setfill('0') << std::hex;
-	ss << "0x" << std::setw(6) << ((byteCount_ & 0xFF00) >> 8) << "\t"
-		<< "0x" << std::setw(6) << (byteCount_ & 0xFF) << std::endl;
-	ss << std::setw(1) << static_cast<int>(valid_) << " "
-		<< std::setw(2) << std::dec << static_cast<int>(subsystemID_) << std::hex << " "
-		<< "0x" << std::setw(2) << linkID_ << "\t";
-	ss << "0x" << std::setw(2) << static_cast<int>(packetType_) << "0x" << std::setw(2) << 0 << std::endl;
-	return ss.str();
+	std::string output;
+	DTC_JSONWriter writer(output);
+	AppendHeaderPacketFormat(writer);
+	return output;
+}
+
+void DTCLib::DTC_DMAPacket::AppendHeaderPacketFormat(DTC_JSONWriter& writer) const
+{
+	writer.PrefixedHex((byteCount_ & 0xFF00) >> 8, 6).Raw("\t").PrefixedHex(byteCount_ & 0xFF, 6).Raw("\n");
+	writer.Dec(valid_).Raw(" ").Dec(subsystemID_, 2).Raw(" ").PrefixedHex(linkID_, 2).Raw("\t");
+	writer.PrefixedHex(packetType_, 2).PrefixedHex(0, 2).Raw("\n");
 }
 
 std::string DTCLib::DTC_DMAPacket::toJSON()
 {
-	std::stringstream ss;
-	ss << "\"DMAPacket\": {\n";
-	ss << headerJSON();
-	ss << "\n}";
-	return ss.str();
+	std::string output;
+	AppendJSON(output);
+	return output;
+}
+
+void DTCLib::DTC_DMAPacket::AppendJSON(std::string& output) const
+{
+	DTC_JSONWriter writer(output);
+	writer.BeginObject("DMAPacket");
+	AppendHeaderJSON(writer);
+	writer.EndObject();
 }
 
 std::string DTCLib::DTC_DMAPacket::toPacketFormat() { return headerPacketFormat(); }
@@ -4,6 +4,7 @@
 #include "artdaq-core-mu2e/Overlays/DTC_Packets/DTC_PacketType.h"
 #include "artdaq-core-mu2e/Overlays/DTC_Packets/DTC_DataPacket.h"
 
+#include "artdaq-core-mu2e/Overlays/DTC_Types/DTC_JSONWriter.h"
 #include "artdaq-core-mu2e/Overlays/DTC_Types/DTC_Link_ID.h"
 
 #include <cstdint>
@@ -95,6 +96,16 @@ public:
 	/// </summary>
 	/// <returns>"packet format" string representation of DMA header information</returns>
 	std::string headerPacketFormat() const;
+	/// <summary>
+	/// Append the DMA Header members (see headerJSON()) to the writer's current object
+	/// </summary>
+	/// <param name="writer">DTC_JSONWriter to append to</param>
+	void AppendHeaderJSON(DTC_JSONWriter& writer) const;
+	/// <summary>
+	/// Append the DMA header in "packet format" (see headerPacketFormat())
+	/// </summary>
+	/// <param name="writer">DTC_JSONWriter to append to</param>
+	void AppendHeaderPacketFormat(DTC_JSONWriter& writer) const;
 
 	/// <summary>
 	/// Returns if the DTC thinks the packet is valid
@@ -144,6 +155,11 @@ public:
 	/// </summary>
 	/// <returns>JSON-formatted string representation of DMA packet</returns>
 	virtual std::string toJSON();
+	/// <summary>
+	/// Append the JSON representation of the DMA Packet (see toJSON()) to a string
+	/// </summary>
+	/// <param name="output">String to append to</param>
+	void AppendJSON(std::string& output) const;
 
 	/// <summary>
 	/// Stream the JSON representation of the DTC_DMAPacket to the given stream
@@ -3,6 +3,8 @@
 
 #include "artdaq-core-mu2e/Overlays/DTC_Packets/DTC_DataHeaderPacket.h"
 #include "artdaq-core-mu2e/Overlays/DTC_Packets/DTC_DataPacket.h"
+#include "artdaq-core-mu2e/Overlays/DTC_Packets/DTC_PacketViews.h"
+#include "artdaq-core-mu2e/Overlays/DTC_Types/DTC_BufferPool.h"
 
 #include <cassert>
 #include <cstdint>
@@ -17,9 +19,9 @@ namespace DTCLib {
 /// </summary>
 struct DTC_DataBlock
 {
-	std::shared_ptr<std::vector<uint8_t>> allocBytes{nullptr};  ///< Used if the block owns its memory
-	const void* blockPointer{nullptr};                          ///< Pointer to DataBlock in Memory
-	size_t byteSize{0};                                         ///< Size of DataBlock
+	std::shared_ptr<DTC_Buffer> allocBytes{nullptr};  ///< Used if the block owns its memory
+	const void* blockPointer{nullptr};                ///< Pointer to DataBlock in Memory
+	size_t byteSize{0};                               ///< Size of DataBlock
 private:
 	mutable std::shared_ptr<DTC_DataHeaderPacket> hdr{nullptr}; //use GetHeader()
 public:
@@ -32,9 +34,9 @@ public:
 	DTC_DataBlock(const void* ptr)
 		: blockPointer(ptr)
 	{
-		DTC_DataPacket pkt(ptr);
-		DTC_DataHeaderPacket hdr(pkt);
-		byteSize = hdr.GetByteCount();
+		DTC_DataHeaderView header(ptr);
+		header.Validate();
+		byteSize = header.GetByteCount();
 	}
 
 	/// <summary>
@@ -45,17 +47,37 @@ public:
 	DTC_DataBlock(const void* ptr, size_t sz)
 		: blockPointer(ptr), byteSize(sz) {}
 
-	DTC_DataBlock(size_t sz)
-		: allocBytes(new std::vector<uint8_t>(sz)), blockPointer(allocBytes->data()), byteSize(sz)
+	/// <summary>
+	/// Create a DTC_DataBlock which owns an uninitialized buffer of the given size
+	/// </summary>
+	/// <param name="sz">Size of DataBlock</param>
+	/// <param name="allocator">Allocator of the buffer, nullptr for DTC_BufferAllocator::Default()</param>
+	DTC_DataBlock(size_t sz, DTC_BufferAllocator* allocator = nullptr)
+		: allocBytes(DTC_Buffer::Make(sz, allocator)), blockPointer(allocBytes->data()), byteSize(sz)
 	{
 	}
 
+	/// <summary>
+	/// Get the Data Header packet, decoded on first use. Concurrent callers may each decode it, but only the first
+	/// result is stored; prefer GetHeaderView() in hot or multi-threaded paths.
+	/// </summary>
 	inline std::shared_ptr<DTC_DataHeaderPacket> GetHeader() const
 	{
 		assert(byteSize >= 16);
-		if (hdr) return hdr;
-		hdr = std::make_shared<DTC_DataHeaderPacket>(DTC_DataPacket(blockPointer));
-		return hdr;
+		auto header = std::atomic_load(&hdr);
+		if (header) return header;
+		auto decoded = std::make_shared<DTC_DataHeaderPacket>(DTC_DataPacket(blockPointer));
+		if (std::atomic_compare_exchange_strong(&hdr, &header, decoded)) return decoded;
+		return header;
+	}
+
+	/// <summary>
+	/// Get a non-owning view of the Data Header packet, without constructing a DTC_DataHeaderPacket
+	/// </summary>
+	inline DTC_DataHeaderView GetHeaderView() const
+	{
+		assert(byteSize >= 16);
+		return DTC_DataHeaderView(blockPointer);
 	}
 
 	inline const void* GetRawBufferPointer() const
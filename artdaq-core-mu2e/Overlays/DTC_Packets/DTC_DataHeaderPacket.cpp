@@ -1,5 +1,6 @@
 #include "artdaq-core-mu2e/Overlays/DTC_Packets/DTC_DataHeaderPacket.h"
 
+#include "artdaq-core-mu2e/Overlays/DTC_Types/DTC_Instrumentation.h"
 #include "artdaq-core-mu2e/Overlays/DTC_Types/Exceptions.h"
 
 #include "TRACE/tracemf.h"
@@ -12,6 +13,8 @@ DTCLib::DTC_DataHeaderPacket::DTC_DataHeaderPacket(DTC_Link_ID link, uint16_t pa
 DTCLib::DTC_DataHeaderPacket::DTC_DataHeaderPacket(DTC_DataPacket in)
 	: DTC_DMAPacket(in)
 {
+	DTC_INSTRUMENT_SCOPE(timer, HeaderDecode);
+	DTC_INSTRUMENT_ADD(timer, 16, 1);
 	if (packetType_ != DTC_PacketType_DataHeader)
 	{
 		auto ex = DTC_WrongPacketTypeException(DTC_PacketType_DataHeader, packetType_);
@@ -39,30 +42,40 @@ DTCLib::DTC_DataHeaderPacket::DTC_DataHeaderPacket(DTC_DataPacket in)
 
 std::string DTCLib::DTC_DataHeaderPacket::toJSON()
 {
-	std::stringstream ss;
-	ss << "\"DataHeaderPacket\": {\n";
-	ss << headerJSON();
-	ss << ",\n\t\"packetCount\": " << std::dec << static_cast<int>(packetCount_);
-	ss << ",\n" << event_tag_.toJSON();
-	ss << ",\n\t\"status\": " << std::dec << static_cast<int>(status_);
-	ss << ",\n\t\"packetVersion\": " << std::hex << static_cast<int>(dataPacketVersion_);
-	ss << ",\n\t\"DTC ID\": " << std::dec << static_cast<int>(dtcId_);
-	ss << ",\n\t\"evbMode\": " << std::hex << "0x" << static_cast<int>(evbMode_);
-	ss << "\n}";
-	return ss.str();
+	std::string output;
+	AppendJSON(output);
+	return output;
+}
+
+void DTCLib::DTC_DataHeaderPacket::AppendJSON(std::string& output) const
+{
+	DTC_JSONWriter writer(output);
+	writer.BeginObject("DataHeaderPacket");
+	AppendHeaderJSON(writer);
+	writer.Field("packetCount", packetCount_);
+	event_tag_.AppendJSON(writer);
+	writer.Field("status", status_);
+	writer.Key("packetVersion").Hex(dataPacketVersion_);
+	writer.Field("DTC ID", dtcId_);
+	writer.HexField("evbMode", evbMode_);
+	writer.EndObject();
 }
 
 std::string DTCLib::DTC_DataHeaderPacket::toPacketFormat()
 {
-	std::stringstream ss;
-	ss << headerPacketFormat() << std::setfill('0') << std::hex;
-	ss << "     0x" << std::setw(1) << ((packetCount_ & 0x0700) >> 8) << "\t"
-		<< "0x" << std::setw(6) << (packetCount_ & 0xFF) << "\n";
-	ss << event_tag_.toPacketFormat();
-	ss << "0x" << std::setw(6) << static_cast<int>(dataPacketVersion_) << "\t"
-		<< "0x" << std::setw(6) << static_cast<int>(status_) << "\n";
-	ss << "0x" << std::setw(6) << static_cast<int>(evbMode_) << "\t" << std::dec << std::setw(8) << static_cast<int>(dtcId_) << "\n";
-	return ss.str();
+	std::string output;
+	AppendPacketFormat(output);
+	return output;
+}
+
+void DTCLib::DTC_DataHeaderPacket::AppendPacketFormat(std::string& output) const
+{
+	DTC_JSONWriter writer(output);
+	AppendHeaderPacketFormat(writer);
+	writer.Raw("     ").PrefixedHex((packetCount_ & 0x0700) >> 8, 1).Raw("\t").PrefixedHex(packetCount_ & 0xFF, 6).Raw("\n");
+	event_tag_.AppendPacketFormat(writer);
+	writer.PrefixedHex(dataPacketVersion_, 6).Raw("\t").PrefixedHex(status_, 6).Raw("\n");
+	writer.PrefixedHex(evbMode_, 6).Raw("\t").Dec(dtcId_, 8).Raw("\n");
 }
 
 DTCLib::DTC_DataPacket DTCLib::DTC_DataHeaderPacket::ConvertToDataPacket() const
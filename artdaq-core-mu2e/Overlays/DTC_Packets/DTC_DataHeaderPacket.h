@@ -106,6 +106,16 @@ public:
 	/// </summary>
 	/// <returns>"packet format" string representation of DTC_DataHeaderPacket</returns>
 	std::string toPacketFormat() override;
+	/// <summary>
+	/// Append the JSON representation of the DTC_DataHeaderPacket (see toJSON()) to a string
+	/// </summary>
+	/// <param name="output">String to append to</param>
+	void AppendJSON(std::string& output) const;
+	/// <summary>
+	/// Append the "packet format" representation of the DTC_DataHeaderPacket (see toPacketFormat()) to a string
+	/// </summary>
+	/// <param name="output">String to append to</param>
+	void AppendPacketFormat(std::string& output) const;
 
 	/// <summary>
 	/// Determine if two Data Header packets are equal (Evaluates DataPacket == DataPacket, see DTC_DataPacket::Equals)
@@ -1,7 +1,6 @@
 #include "artdaq-core-mu2e/Overlays/DTC_Packets/DTC_DataPacket.h"
 
-#include <iomanip>
-#include <sstream>
+#include "artdaq-core-mu2e/Overlays/DTC_Types/DTC_JSONWriter.h"
 
 DTCLib::DTC_DataPacket::DTC_DataPacket()
 {
@@ -65,34 +64,36 @@ bool DTCLib::DTC_DataPacket::Resize(const uint16_t dmaSize)
 
 std::string DTCLib::DTC_DataPacket::toJSON() const
 {
-	std::stringstream ss;
-	ss << "\"DataPacket\": {";
-	ss << "\"data\": [";
-	ss << std::hex << std::setfill('0');
-	uint16_t jj = 0;
-	for (uint16_t ii = 0; ii < dataSize_ - 2; ii += 2)
-	{
-		ss << "0x" << std::setw(4) << static_cast<int>(reinterpret_cast<uint16_t const*>(dataPtr_)[jj]) << ",";
-		++jj;
-	}
-	ss << "0x" << std::setw(4) << static_cast<int>(reinterpret_cast<uint16_t const*>(dataPtr_)[jj]) << "]";
-	ss << "}";
-	return ss.str();
+	std::string output;
+	AppendJSON(output);
+	return output;
 }
 
 std::string DTCLib::DTC_DataPacket::toPacketFormat() const
 {
-	std::stringstream ss;
-	ss << "\"data\": [";
-	ss << std::hex << std::setfill('0');
-	uint16_t jj = 0;
-	for (uint16_t ii = 0; ii < dataSize_ - 2; ii += 2)
+	std::string output;
+	AppendPacketFormat(output);
+	return output;
+}
+
+void DTCLib::DTC_DataPacket::AppendJSON(std::string& output) const
+{
+	output += "\"DataPacket\": {";
+	AppendPacketFormat(output);
+	output += "}";
+}
+
+void DTCLib::DTC_DataPacket::AppendPacketFormat(std::string& output) const
+{
+	DTC_JSONWriter writer(output);
+	writer.Raw("\"data\": [");
+	auto words = reinterpret_cast<uint16_t const*>(dataPtr_);
+	for (uint16_t jj = 0; jj < dataSize_ / 2; ++jj)
 	{
-		ss << "0x" << std::setw(4) << static_cast<int>(reinterpret_cast<uint16_t const*>(dataPtr_)[jj]) << ",";
-		++jj;
+		if (jj > 0) writer.Raw(",");
+		writer.PrefixedHex(words[jj], 4);
 	}
-	ss << "0x" << std::setw(4) << static_cast<int>(reinterpret_cast<uint16_t const*>(dataPtr_)[jj]) << "]";
-	return ss.str();
+	writer.Raw("]");
 }
 
 bool DTCLib::DTC_DataPacket::Equals(const DTC_DataPacket& other) const
@@ -81,6 +81,16 @@ public:
 	/// <returns>"packet format" string representation of the DTC_DataPacket</returns>
 	std::string toPacketFormat() const;
 	/// <summary>
+	/// Append the JSON representation of the DTC_DataPacket (see toJSON()) to a string
+	/// </summary>
+	/// <param name="output">String to append to</param>
+	void AppendJSON(std::string& output) const;
+	/// <summary>
+	/// Append the "packet format" representation of the DTC_DataPacket (see toPacketFormat()) to a string
+	/// </summary>
+	/// <param name="output">String to append to</param>
+	void AppendPacketFormat(std::string& output) const;
+	/// <summary>
 	/// Resize a DTC_DataPacket in "owner" mode. New size must be larger than current.
 	/// </summary>
 	/// <param name="dmaSize">Size in bytes of the new packet</param>
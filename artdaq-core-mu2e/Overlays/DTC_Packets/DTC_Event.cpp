@@ -1,5 +1,8 @@
 #include "artdaq-core-mu2e/Overlays/DTC_Packets/DTC_Event.h"
 
+#include "artdaq-core-mu2e/Overlays/DTC_Packets/DTC_LinkStatistics.h"
+
+#include "artdaq-core-mu2e/Overlays/DTC_Types/DTC_Instrumentation.h"
 #include "artdaq-core-mu2e/Overlays/DTC_Types/Exceptions.h"
 #include "artdaq-core-mu2e/Overlays/DTC_Types/Utilities.h"
 
@@ -12,14 +15,15 @@ DTCLib::DTC_Event::DTC_Event(const void* data)
 	TLOG(TLVL_TRACE) << "Header of DTC_Event " << GetEventWindowTag().GetEventWindowTag(true) << " created, copy in data and call SetupEvent to finalize";
 }
 
-DTCLib::DTC_Event::DTC_Event(size_t data_size)
-	: allocBytes(new std::vector<uint8_t>(data_size)), header_(), sub_events_(), buffer_ptr_(allocBytes->data())
+DTCLib::DTC_Event::DTC_Event(size_t data_size, DTC_BufferAllocator* allocator)
+	: allocBytes(DTC_Buffer::Make(data_size, allocator)), header_(), sub_events_(), buffer_ptr_(allocBytes->data())
 {
 	TLOG(TLVL_TRACE) << "Empty DTC_Event created, copy in data and call SetupEvent to finalize";
 }
 
 void DTCLib::DTC_Event::SetupEvent()
 {
+	DTC_INSTRUMENT_SCOPE(timer, SetupEvent);
 	auto ptr = reinterpret_cast<const uint8_t*>(buffer_ptr_);
 
 	memcpy(&header_, ptr, sizeof(header_));
@@ -29,6 +33,10 @@ void DTCLib::DTC_Event::SetupEvent()
 	while (byte_count < header_.inclusive_event_byte_count)
 	{
 		TLOG(TLVL_DEBUG + 6) << "Current byte_count is " << byte_count << " / " << header_.inclusive_event_byte_count << ", creating sub event";
+		// Taken from the raw header, as the DTC_SubEvent constructor may throw before the subevent is added
+		DTC_SubEventHeader subHeader;
+		memcpy(&subHeader, ptr, sizeof(subHeader));
+		uint8_t dtcID = subHeader.source_dtc_id;
 		try 
 		{
 			sub_events_.emplace_back(ptr);
@@ -47,15 +55,18 @@ void DTCLib::DTC_Event::SetupEvent()
 		{
 			TLOG(TLVL_ERROR) << "A DTC_WrongPacketTypeException occurred while setting up the event at location 0x" << std::hex << byte_count;
 			TLOG(TLVL_ERROR) << "This event has been truncated.";
+			if (auto stats = DTC_LinkStatistics::Active()) stats->RecordTruncation(dtcID);
 			break;
 		}
 		catch (DTC_WrongPacketSizeException const& ex) 
 		{
 			TLOG(TLVL_ERROR) << "A DTC_WrongPacketSizeException occurred while setting up the event at location 0x" << std::hex << byte_count;
 			TLOG(TLVL_ERROR) << "This event has been truncated.";
+			if (auto stats = DTC_LinkStatistics::Active()) stats->RecordTruncation(dtcID);
 			break;
 		}
 	}
+	DTC_INSTRUMENT_ADD(timer, byte_count, sub_events_.size());
 } //end SetupEvent()
 
 DTCLib::DTC_EventWindowTag DTCLib::DTC_Event::GetEventWindowTag() const
@@ -112,7 +123,7 @@ void DTCLib::DTC_Event::WriteEvent(std::ostream& o, bool includeDMAWriteSize)
 			auto ii = 0;
 			for (auto& blk : subevt.GetDataBlocks())
 			{
-				TLOG(TLVL_TRACE) << "Writing Data Block " << ii << ", roc=" << blk.GetHeader()->GetLinkID() << ", sz=" << blk.byteSize;
+				TLOG(TLVL_TRACE) << "Writing Data Block " << ii << ", roc=" << blk.GetHeaderView().GetLinkID() << ", sz=" << blk.byteSize;
 				o.write(static_cast<const char*>(blk.blockPointer), blk.byteSize);
 				++ii;
 			}
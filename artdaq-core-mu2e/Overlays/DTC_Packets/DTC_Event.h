@@ -4,6 +4,7 @@
 #include "artdaq-core-mu2e/Overlays/DTC_Packets/DTC_SubEvent.h"
 #include "artdaq-core-mu2e/Overlays/DTC_Packets/DTC_EventHeader.h"
 
+#include "artdaq-core-mu2e/Overlays/DTC_Types/DTC_BufferPool.h"
 #include "artdaq-core-mu2e/Overlays/DTC_Types/DTC_Subsystem.h"
 #include "artdaq-core-mu2e/Overlays/DTC_Types/DTC_EventMode.h"
 #include "artdaq-core-mu2e/Overlays/DTC_Types/DTC_EventWindowTag.h"
@@ -24,7 +25,13 @@ public:
 	/// <param name="data">Pointer data</param>
 	explicit DTC_Event(const void* data);
 
-	explicit DTC_Event(size_t data_size);
+	/// <summary>
+	/// Construct a DTC_Event which owns an uninitialized buffer of the given size. Copy the event into
+	/// GetRawBufferPointer(), then call SetupEvent.
+	/// </summary>
+	/// <param name="data_size">Size of the buffer, in bytes</param>
+	/// <param name="allocator">Allocator of the buffer, nullptr for DTC_BufferAllocator::Default()</param>
+	explicit DTC_Event(size_t data_size, DTC_BufferAllocator* allocator = nullptr);
 
 	DTC_Event()
 		: header_(), sub_events_(), buffer_ptr_(nullptr) {}
@@ -75,10 +82,20 @@ public:
 
 	void AddSubEvent(DTC_SubEvent subEvt)
 	{
-		sub_events_.push_back(subEvt);
+		sub_events_.push_back(std::move(subEvt));
 		header_.num_dtcs++;
 		UpdateHeader();
 	}
+	/// <summary>
+	/// Replace the subevents of the event, updating the header once
+	/// </summary>
+	/// <param name="subEvts">Subevents of the event</param>
+	void SetSubEvents(std::vector<DTC_SubEvent> subEvts)
+	{
+		sub_events_ = std::move(subEvts);
+		header_.num_dtcs = sub_events_.size();
+		UpdateHeader();
+	}
 	DTC_SubEvent* GetSubEventByDTCID(uint8_t dtc, DTC_Subsystem subsys)
 	{
 		for (size_t ii = 0; ii < sub_events_.size(); ++ii)
@@ -104,7 +121,7 @@ public:
 		for(auto& subevt : sub_events_) {
 			if(subevt.HasSubsystem(subsys)) {
 				for(auto& datablock : subevt.GetDataBlocks()) {
-					if(datablock.GetHeader()->GetSubsystem() == subsys) {
+					if(datablock.GetHeaderView().GetSubsystem() == subsys) {
 						output.push_back(datablock);
 					}
 				}
@@ -114,12 +131,13 @@ public:
 	}
 
 	DTC_EventHeader* GetHeader() { return &header_; }
+	const DTC_EventHeader* GetHeader() const { return &header_; }
 
 	void UpdateHeader();
 	void WriteEvent(std::ostream& output, bool includeDMAWriteSize = true);
 
 private:
-	std::shared_ptr<std::vector<uint8_t>> allocBytes{nullptr};  ///< Used if the block owns its memory
+	std::shared_ptr<DTC_Buffer> allocBytes{nullptr};  ///< Used if the block owns its memory
 	DTC_EventHeader header_;
 	std::vector<DTC_SubEvent> sub_events_;
 	const void* buffer_ptr_;
@@ -1,6 +1,8 @@
 #ifndef artdaq_core_mu2e_Overlays_DTC_Packets_DTC_EventHeader_h
 #define artdaq_core_mu2e_Overlays_DTC_Packets_DTC_EventHeader_h
 
+#include "artdaq-core-mu2e/Overlays/DTC_Types/DTC_JSONWriter.h"
+
 #include <cstdint>
 #include <iomanip>
 #include <sstream>
@@ -44,23 +46,31 @@ struct DTC_EventHeader
 
 	inline std::string toJson() const
 	{
-		std::ostringstream oss;
-
-		oss << "\"DTC_EventHeader\": {\n";
-		oss << "\t\"inclusive_event_byte_count\": " << inclusive_event_byte_count;
-		oss << ",\n\t\"event_tag_low\": " << event_tag_low;
-		oss << ",\n\t\"event_tag_high\": " << event_tag_high;
-		oss << ",\n\t\"num_dtcs\": " << num_dtcs;
-		oss << ",\n\t\"event_mode\": 0x" << std::hex << event_mode;
-		oss << ",\n\t\"dtc_mac\": " << dtc_mac;
-		oss << ",\n\t\"partition_id\": " << partition_id;
-		oss << ",\n\t\"evb_mode\": " << evb_mode;
-		oss << ",\n\t\"evb_id\": " << evb_id;
-		oss << ",\n\t\"evb_status\": " << evb_status;
-		oss << ",\n\t\"emtdc\": " << emtdc;
-		oss << "\n}";
+		std::string output;
+		AppendJson(output);
+		return output;
+	}
 
-		return oss.str();
+	/// <summary>
+	/// Append the JSON representation (see toJson()) to a string
+	/// </summary>
+	/// <param name="output">String to append to</param>
+	inline void AppendJson(std::string& output) const
+	{
+		DTC_JSONWriter writer(output);
+		writer.BeginObject("DTC_EventHeader");
+		writer.Field("inclusive_event_byte_count", inclusive_event_byte_count);
+		writer.Field("event_tag_low", event_tag_low);
+		writer.Field("event_tag_high", event_tag_high);
+		writer.Field("num_dtcs", num_dtcs);
+		writer.HexField("event_mode", event_mode);
+		writer.Field("dtc_mac", dtc_mac);
+		writer.Field("partition_id", partition_id);
+		writer.Field("evb_mode", evb_mode);
+		writer.Field("evb_id", evb_id);
+		writer.Field("evb_status", evb_status);
+		writer.Field("emtdc", emtdc);
+		writer.EndObject();
 	}
 };
 
@@ -0,0 +1,136 @@
+#include "artdaq-core-mu2e/Overlays/DTC_Packets/DTC_EventMerger.h"
+
+#include "TRACE/tracemf.h"
+
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+#include <string>
+
+DTCLib::DTC_EventMerger::DTC_EventMerger(Config const& config)
+	: config_(config), streams_(config.nStreams), lastPushed_(config.nStreams), seen_(config.nStreams, false), present_(config.nStreams, false)
+{
+	if (config_.expectedDTCs == 0) config_.expectedDTCs = config_.nStreams;
+	heap_.reserve(config_.nStreams);
+}
+
+void DTCLib::DTC_EventMerger::PushHead(size_t stream)
+{
+	heap_.push_back({streams_[stream].front().ewt, stream});
+	std::push_heap(heap_.begin(), heap_.end(), std::greater<HeapItem>());
+}
+
+void DTCLib::DTC_EventMerger::PopHeap()
+{
+	std::pop_heap(heap_.begin(), heap_.end(), std::greater<HeapItem>());
+	heap_.pop_back();
+}
+
+bool DTCLib::DTC_EventMerger::Push(size_t stream, DTC_SubEvent subEvent, clock::time_point now)
+{
+	if (stream >= streams_.size()) throw std::out_of_range("Stream " + std::to_string(stream) + " is out of range (max: " + std::to_string(streams_.size() - 1) + ")");
+
+	auto ewt = subEvent.GetEventWindowTag().GetEWT();
+	if ((seen_[stream] && ewt <= lastPushed_[stream]) || (emittedAny_ && ewt <= lastEmitted_))
+	{
+		TLOG(TLVL_WARNING, "DTC_EventMerger") << "Dropping subevent with EWT " << ewt.value() << " from stream " << stream
+											  << ": last pushed on this stream " << lastPushed_[stream].value() << ", last emitted " << lastEmitted_.value();
+		++late_;
+		return false;
+	}
+	seen_[stream] = true;
+	lastPushed_[stream] = ewt;
+
+	auto& queue = streams_[stream];
+	queue.push_back({std::move(subEvent), ewt, now});
+	++pending_;
+	if (queue.size() == 1)
+	{
+		PushHead(stream);
+		++nonEmpty_;
+	}
+	return true;
+}
+
+bool DTCLib::DTC_EventMerger::EmitOne(std::vector<MergedEvent>& out, bool force, clock::time_point now)
+{
+	if (heap_.empty()) return false;
+
+	auto const top = heap_.front();
+	// Streams are EWT-ordered, so once every stream has a head, nothing earlier than the top can still arrive
+	if (!force && nonEmpty_ < streams_.size() && now - streams_[top.stream].front().arrival < config_.timeout)
+	{
+		return false;
+	}
+
+	MergedEvent merged;
+	merged.ewt = top.ewt;
+	merged.event.SetEventWindowTag(DTC_EventWindowTag(top.ewt));
+
+	// Collected first and handed over at once, so that the event header is only updated once
+	std::fill(present_.begin(), present_.end(), false);
+	std::vector<DTC_SubEvent> subEvents;
+	subEvents.reserve(std::min(heap_.size(), streams_.size()));
+	while (!heap_.empty() && heap_.front().ewt == top.ewt)
+	{
+		auto stream = heap_.front().stream;
+		PopHeap();
+
+		auto& queue = streams_[stream];
+		if (subEvents.empty())
+		{
+			merged.event.GetHeader()->event_mode = queue.front().subEvent.GetHeader()->event_mode;
+		}
+		subEvents.push_back(std::move(queue.front().subEvent));
+		present_[stream] = true;
+		queue.pop_front();
+		--pending_;
+
+		if (queue.empty())
+			--nonEmpty_;
+		else
+			PushHead(stream);
+	}
+
+	merged.event.SetSubEvents(std::move(subEvents));
+
+	for (size_t ii = 0; ii < present_.size(); ++ii)
+	{
+		if (!present_[ii]) merged.missingStreams.push_back(ii);
+	}
+	merged.dtc_check = merged.missingStreams.empty();
+	merged.ndtc_check = merged.event.GetSubEventCount() == config_.expectedDTCs;
+
+	lastEmitted_ = top.ewt;
+	emittedAny_ = true;
+
+	if (!merged.dtc_check)
+	{
+		TLOG(TLVL_DEBUG + 5, "DTC_EventMerger") << "Event " << top.ewt.value() << " is missing " << merged.missingStreams.size() << " of " << streams_.size() << " DTCs";
+		if (!config_.emitIncomplete)
+		{
+			++droppedEvents_;
+			return true;
+		}
+	}
+	out.push_back(std::move(merged));
+	return true;
+}
+
+size_t DTCLib::DTC_EventMerger::Pop(std::vector<MergedEvent>& out, clock::time_point now)
+{
+	auto before = out.size();
+	while (EmitOne(out, false, now))
+	{
+	}
+	return out.size() - before;
+}
+
+size_t DTCLib::DTC_EventMerger::Flush(std::vector<MergedEvent>& out)
+{
+	auto before = out.size();
+	while (EmitOne(out, true, clock::now()))
+	{
+	}
+	return out.size() - before;
+}
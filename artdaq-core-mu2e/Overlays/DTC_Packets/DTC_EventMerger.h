@@ -0,0 +1,123 @@
+#ifndef artdaq_core_mu2e_Overlays_DTC_Packets_DTC_EventMerger_h
+#define artdaq_core_mu2e_Overlays_DTC_Packets_DTC_EventMerger_h
+
+#include "artdaq-core-mu2e/Overlays/DTC_Packets/DTC_Event.h"
+#include "artdaq-core-mu2e/Overlays/DTC_Packets/DTC_SubEvent.h"
+
+#include "artdaq-core-mu2e/Overlays/DTC_Types/DTC_EWT.h"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+namespace DTCLib {
+
+/// <summary>
+/// Assembles DTC_Events from N streams of DTC_SubEvents, one stream per DTC, each ordered by Event Window Tag.
+/// Stream heads are kept in a min-heap on EWT, so that each event is assembled in O(log N) per subevent.
+/// An event is emitted as soon as every stream has data at or past its EWT, or once it has waited for the
+/// configured timeout.
+/// </summary>
+class DTC_EventMerger
+{
+public:
+	using clock = std::chrono::steady_clock;
+
+	struct Config
+	{
+		size_t nStreams{1};                          ///< Number of subevent streams (DTCs)
+		size_t expectedDTCs{0};                      ///< Number of DTCs expected per event (0: nStreams)
+		std::chrono::microseconds timeout{100000};  ///< How long to wait for missing subevents
+		bool emitIncomplete{true};                   ///< If false, events with missing DTCs are dropped instead of emitted
+	};
+
+	/// <summary>
+	/// An assembled event. The check flags follow mu2e::EventHeader, where 1 (after initErrorChecks()) means the
+	/// check passed, and can be copied into it directly.
+	/// </summary>
+	struct MergedEvent
+	{
+		DTC_Event event;
+		DTC_EWT ewt;
+		bool dtc_check{true};                ///< Every stream contributed a subevent
+		bool ndtc_check{true};               ///< Number of subevents matches Config::expectedDTCs
+		std::vector<size_t> missingStreams;  ///< Streams which did not contribute a subevent
+	};
+
+	explicit DTC_EventMerger(Config const& config);
+
+	/// <summary>
+	/// Add a subevent to a stream. Subevents must be pushed in EWT order within each stream; a subevent whose EWT
+	/// is not later than the last one pushed on its stream, or than the last event emitted, is dropped.
+	/// </summary>
+	/// <param name="stream">Stream index</param>
+	/// <param name="subEvent">Subevent to add</param>
+	/// <param name="now">Arrival time, used for the timeout</param>
+	/// <returns>Whether the subevent was accepted</returns>
+	bool Push(size_t stream, DTC_SubEvent subEvent, clock::time_point now = clock::now());
+
+	/// <summary>
+	/// Emit all events which are complete, or have timed out
+	/// </summary>
+	/// <param name="out">Events are appended to this vector</param>
+	/// <param name="now">Current time, used for the timeout</param>
+	/// <returns>Number of events appended</returns>
+	size_t Pop(std::vector<MergedEvent>& out, clock::time_point now = clock::now());
+
+	/// <summary>
+	/// Emit all pending events regardless of completeness or timeout, e.g. at end of run
+	/// </summary>
+	/// <param name="out">Events are appended to this vector</param>
+	/// <returns>Number of events appended</returns>
+	size_t Flush(std::vector<MergedEvent>& out);
+
+	/// <summary>
+	/// Get the number of subevents waiting to be merged
+	/// </summary>
+	size_t GetPendingCount() const { return pending_; }
+	/// <summary>
+	/// Get the number of subevents dropped because they arrived out of order or too late
+	/// </summary>
+	size_t GetLateCount() const { return late_; }
+	/// <summary>
+	/// Get the number of incomplete events dropped (only if Config::emitIncomplete is false)
+	/// </summary>
+	size_t GetDroppedEventCount() const { return droppedEvents_; }
+
+private:
+	struct Entry
+	{
+		DTC_SubEvent subEvent;
+		DTC_EWT ewt;
+		clock::time_point arrival;
+	};
+	struct HeapItem
+	{
+		DTC_EWT ewt;
+		size_t stream;
+		bool operator>(HeapItem const& r) const { return ewt > r.ewt || (ewt == r.ewt && stream > r.stream); }
+	};
+
+	bool EmitOne(std::vector<MergedEvent>& out, bool force, clock::time_point now);
+	void PushHead(size_t stream);
+	void PopHeap();
+
+	Config config_;
+	std::vector<std::deque<Entry>> streams_;
+	std::vector<DTC_EWT> lastPushed_;
+	std::vector<bool> seen_;     ///< Whether anything has been pushed on the stream yet
+	std::vector<bool> present_;  ///< Scratch for EmitOne: whether the stream contributed to the current event
+	std::vector<HeapItem> heap_;  ///< Min-heap of the head of each non-empty stream
+	size_t nonEmpty_{0};
+	size_t pending_{0};
+	size_t late_{0};
+	size_t droppedEvents_{0};
+	bool emittedAny_{false};
+	DTC_EWT lastEmitted_;
+};
+
+}  // namespace DTCLib
+
+#endif  // artdaq_core_mu2e_Overlays_DTC_Packets_DTC_EventMerger_h
@@ -0,0 +1,255 @@
+#include "artdaq-core-mu2e/Overlays/DTC_Packets/DTC_EventPipeline.h"
+
+#include "TRACE/tracemf.h"
+
+#include <stdexcept>
+
+DTCLib::DTC_EventPipeline::DTC_EventPipeline(Config const& config, Reader reader, Stage parser, Stage decoder, Sink sink)
+	: config_(config)
+	, reader_(std::move(reader))
+	, parser_(std::move(parser))
+	, decoder_(std::move(decoder))
+	, sink_(std::move(sink))
+	, readQueue_(config.queueDepth)
+	, parsedQueue_(config.queueDepth)
+	, decodedQueue_(config.queueDepth)
+{
+	if (config_.decoderThreads == 0) config_.decoderThreads = 1;
+	if (config_.batchSize == 0) config_.batchSize = 1;
+}
+
+DTCLib::DTC_EventPipeline::~DTC_EventPipeline()
+{
+	Stop();
+	for (auto& thread : threads_)
+	{
+		if (thread.joinable()) thread.join();
+	}
+}
+
+void DTCLib::DTC_EventPipeline::Start()
+{
+	if (!threads_.empty())
+	{
+		TLOG(TLVL_ERROR) << "DTC_EventPipeline::Start called while the pipeline is running";
+		throw std::logic_error("DTC_EventPipeline is already running");
+	}
+	stop_ = false;
+	readerDone_ = false;
+	parserDone_ = false;
+	decodersRunning_ = config_.decoderThreads;
+	error_ = nullptr;
+
+	TLOG(TLVL_DEBUG) << "Starting DTC_EventPipeline with " << config_.decoderThreads << " decoder threads, queue depth " << readQueue_.Capacity();
+	threads_.emplace_back(&DTC_EventPipeline::ReaderLoop, this);
+	threads_.emplace_back(&DTC_EventPipeline::ParserLoop, this);
+	for (size_t ii = 0; ii < config_.decoderThreads; ++ii) threads_.emplace_back(&DTC_EventPipeline::DecoderLoop, this);
+	threads_.emplace_back(&DTC_EventPipeline::SinkLoop, this);
+}
+
+void DTCLib::DTC_EventPipeline::Wait()
+{
+	for (auto& thread : threads_) thread.join();
+	threads_.clear();
+
+	auto stats = GetStats();
+	TLOG(TLVL_DEBUG) << "DTC_EventPipeline finished: read " << stats.read << ", parsed " << stats.parsed << ", decoded " << stats.decoded
+					 << ", sunk " << stats.sunk << ", parse errors " << stats.parseErrors << ", decode errors " << stats.decodeErrors;
+	if (error_) std::rethrow_exception(error_);
+}
+
+DTCLib::DTC_EventPipeline::Stats DTCLib::DTC_EventPipeline::GetStats() const
+{
+	Stats output;
+	output.read = read_.load(std::memory_order_relaxed);
+	output.parsed = parsed_.load(std::memory_order_relaxed);
+	output.decoded = decoded_.load(std::memory_order_relaxed);
+	output.sunk = sunk_.load(std::memory_order_relaxed);
+	output.parseErrors = parseErrors_.load(std::memory_order_relaxed);
+	output.decodeErrors = decodeErrors_.load(std::memory_order_relaxed);
+	return output;
+}
+
+void DTCLib::DTC_EventPipeline::Fail(std::exception_ptr error)
+{
+	{
+		std::lock_guard<std::mutex> lock(errorMutex_);
+		if (!error_) error_ = error;
+	}
+	Stop();
+}
+
+template<typename Queue>
+bool DTCLib::DTC_EventPipeline::PushAll(Queue& queue, std::vector<DTC_EventHandle>& items)
+{
+	DTC_QueueBackoff backoff;
+	size_t pushed = 0;
+	while (pushed < items.size())
+	{
+		auto count = queue.PushBatch(items.data() + pushed, items.size() - pushed);
+		pushed += count;
+		if (count > 0)
+		{
+			backoff.Reset();
+			continue;
+		}
+		if (stop_.load(std::memory_order_acquire)) return false;
+		backoff.Pause();
+	}
+	items.clear();
+	return true;
+}
+
+void DTCLib::DTC_EventPipeline::ReaderLoop()
+{
+	std::vector<DTC_EventHandle> batch;
+	batch.reserve(config_.batchSize);
+	try
+	{
+		bool more = true;
+		while (more && !stop_.load(std::memory_order_acquire))
+		{
+			DTC_EventHandle handle;
+			more = reader_(handle);
+			if (more)
+			{
+				handle.SetSequence(read_.fetch_add(1, std::memory_order_relaxed));
+				batch.push_back(std::move(handle));
+			}
+			// Hand over a full batch, or whatever there is as soon as the parser is idle
+			if (batch.size() >= config_.batchSize || (!batch.empty() && (!more || readQueue_.SizeApprox() == 0)))
+			{
+				if (!PushAll(readQueue_, batch)) break;
+			}
+		}
+	}
+	catch (...)
+	{
+		TLOG(TLVL_ERROR) << "DTC_EventPipeline reader threw after " << read_.load() << " events, stopping the pipeline";
+		Fail(std::current_exception());
+	}
+	readerDone_.store(true, std::memory_order_release);
+}
+
+void DTCLib::DTC_EventPipeline::ParserLoop()
+{
+	std::vector<DTC_EventHandle> input(config_.batchSize);
+	std::vector<DTC_EventHandle> output;
+	output.reserve(config_.batchSize);
+	DTC_QueueBackoff backoff;
+	while (!stop_.load(std::memory_order_acquire))
+	{
+		// Read the flag before popping: once it is set, everything the reader pushed is visible
+		auto done = readerDone_.load(std::memory_order_acquire);
+		auto count = readQueue_.PopBatch(input.data(), input.size());
+		if (count == 0)
+		{
+			if (done) break;
+			backoff.Pause();
+			continue;
+		}
+		backoff.Reset();
+
+		for (size_t ii = 0; ii < count; ++ii)
+		{
+			try
+			{
+				if (parser_)
+					parser_(input[ii]);
+				else
+					input[ii]->SetupEvent();
+				parsed_.fetch_add(1, std::memory_order_relaxed);
+				output.push_back(std::move(input[ii]));
+			}
+			catch (std::exception const& ex)
+			{
+				parseErrors_.fetch_add(1, std::memory_order_relaxed);
+				TLOG(TLVL_ERROR) << "DTC_EventPipeline parser threw for event " << input[ii].GetSequence() << ", dropping it: " << ex.what();
+			}
+			catch (...)
+			{
+				parseErrors_.fetch_add(1, std::memory_order_relaxed);
+				TLOG(TLVL_ERROR) << "DTC_EventPipeline parser threw an unknown exception for event " << input[ii].GetSequence() << ", dropping it";
+			}
+			input[ii] = DTC_EventHandle();
+		}
+		if (!PushAll(parsedQueue_, output)) break;
+	}
+	parserDone_.store(true, std::memory_order_release);
+}
+
+void DTCLib::DTC_EventPipeline::DecoderLoop()
+{
+	std::vector<DTC_EventHandle> input(config_.batchSize);
+	std::vector<DTC_EventHandle> output;
+	output.reserve(config_.batchSize);
+	DTC_QueueBackoff backoff;
+	while (!stop_.load(std::memory_order_acquire))
+	{
+		auto done = parserDone_.load(std::memory_order_acquire);
+		auto count = parsedQueue_.PopBatch(input.data(), input.size());
+		if (count == 0)
+		{
+			if (done) break;
+			backoff.Pause();
+			continue;
+		}
+		backoff.Reset();
+
+		for (size_t ii = 0; ii < count; ++ii)
+		{
+			try
+			{
+				if (decoder_) decoder_(input[ii]);
+				decoded_.fetch_add(1, std::memory_order_relaxed);
+				output.push_back(std::move(input[ii]));
+			}
+			catch (std::exception const& ex)
+			{
+				decodeErrors_.fetch_add(1, std::memory_order_relaxed);
+				TLOG(TLVL_ERROR) << "DTC_EventPipeline decoder threw for event " << input[ii].GetSequence() << ", dropping it: " << ex.what();
+			}
+			catch (...)
+			{
+				decodeErrors_.fetch_add(1, std::memory_order_relaxed);
+				TLOG(TLVL_ERROR) << "DTC_EventPipeline decoder threw an unknown exception for event " << input[ii].GetSequence() << ", dropping it";
+			}
+			input[ii] = DTC_EventHandle();
+		}
+		if (!PushAll(decodedQueue_, output)) break;
+	}
+	decodersRunning_.fetch_sub(1, std::memory_order_acq_rel);
+}
+
+void DTCLib::DTC_EventPipeline::SinkLoop()
+{
+	std::vector<DTC_EventHandle> input(config_.batchSize);
+	DTC_QueueBackoff backoff;
+	try
+	{
+		while (!stop_.load(std::memory_order_acquire))
+		{
+			auto done = decodersRunning_.load(std::memory_order_acquire) == 0;
+			auto count = decodedQueue_.PopBatch(input.data(), input.size());
+			if (count == 0)
+			{
+				if (done) break;
+				backoff.Pause();
+				continue;
+			}
+			backoff.Reset();
+
+			for (size_t ii = 0; ii < count; ++ii)
+			{
+				sink_(std::move(input[ii]));
+				sunk_.fetch_add(1, std::memory_order_relaxed);
+				input[ii] = DTC_EventHandle();
+			}
+		}
+	}
+	catch (...)
+	{
+		TLOG(TLVL_ERROR) << "DTC_EventPipeline sink threw after " << sunk_.load() << " events, stopping the pipeline";
+		Fail(std::current_exception());
+	}
+}
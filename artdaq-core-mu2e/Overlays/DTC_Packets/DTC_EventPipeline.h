@@ -0,0 +1,147 @@
+#ifndef artdaq_core_mu2e_Overlays_DTC_Packets_DTC_EventPipeline_h
+#define artdaq_core_mu2e_Overlays_DTC_Packets_DTC_EventPipeline_h
+
+#include "artdaq-core-mu2e/Overlays/DTC_Packets/DTC_EventQueue.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace DTCLib {
+
+/// <summary>
+/// Multi-threaded event pipeline: one reader thread, one parser thread, N decoder threads and one sink thread,
+/// connected by bounded lock-free queues (DTC_SPSCQueue from reader to parser, DTC_MPMCQueue to and from the
+/// decoders). Events are handed over as DTC_EventHandles, in batches. A full queue blocks the stage pushing into it,
+/// so a slow sink throttles the reader instead of buffering without bound.
+///
+/// With more than one decoder thread, the sink receives events out of reading order; use
+/// DTC_EventHandle::GetSequence to restore it if needed.
+///
+/// Exceptions thrown by the parser or a decoder are logged, and the event is dropped and counted. An exception
+/// thrown by the reader or the sink stops the pipeline, and is rethrown by Wait.
+/// </summary>
+class DTC_EventPipeline
+{
+public:
+	struct Config
+	{
+		size_t queueDepth{64};     ///< Capacity of each queue, in events
+		size_t decoderThreads{1};  ///< Number of decoder threads
+		size_t batchSize{16};      ///< Maximum number of events handed over at once
+	};
+
+	/// <summary>
+	/// Produce the next event. Returns false at the end of the input. The pipeline sets the sequence number of each
+	/// event to its position in the reading order.
+	/// </summary>
+	using Reader = std::function<bool(DTC_EventHandle&)>;
+	/// <summary>
+	/// Process an event in place (parser and decoders)
+	/// </summary>
+	using Stage = std::function<void(DTC_EventHandle&)>;
+	/// <summary>
+	/// Consume a finished event
+	/// </summary>
+	using Sink = std::function<void(DTC_EventHandle&&)>;
+
+	/// <summary>
+	/// Counters of the pipeline, updated as events pass each stage
+	/// </summary>
+	struct Stats
+	{
+		uint64_t read{0};
+		uint64_t parsed{0};
+		uint64_t decoded{0};
+		uint64_t sunk{0};
+		uint64_t parseErrors{0};   ///< Events dropped because the parser threw
+		uint64_t decodeErrors{0};  ///< Events dropped because a decoder threw
+	};
+
+	/// <summary>
+	/// Construct a pipeline. No thread is started until Start.
+	/// </summary>
+	/// <param name="config">Configuration</param>
+	/// <param name="reader">Reader, called on the reader thread</param>
+	/// <param name="parser">Parser, called on the parser thread; nullptr to call DTC_Event::SetupEvent</param>
+	/// <param name="decoder">Decoder, called concurrently on the decoder threads; nullptr to pass events through</param>
+	/// <param name="sink">Sink, called on the sink thread</param>
+	DTC_EventPipeline(Config const& config, Reader reader, Stage parser, Stage decoder, Sink sink);
+	/// <summary>
+	/// Stop the pipeline if it is running, and join its threads
+	/// </summary>
+	~DTC_EventPipeline();
+
+	DTC_EventPipeline(DTC_EventPipeline const&) = delete;
+	DTC_EventPipeline& operator=(DTC_EventPipeline const&) = delete;
+
+	/// <summary>
+	/// Start the threads
+	/// </summary>
+	void Start();
+	/// <summary>
+	/// Ask every stage to stop as soon as possible; events in flight are dropped. Does not wait.
+	/// </summary>
+	void Stop() { stop_.store(true, std::memory_order_release); }
+	/// <summary>
+	/// Wait until all events have reached the sink (or the pipeline was stopped), and join the threads
+	/// </summary>
+	/// <exception>The exception thrown by the reader or the sink, if any</exception>
+	void Wait();
+	/// <summary>
+	/// Start, then Wait
+	/// </summary>
+	void Run()
+	{
+		Start();
+		Wait();
+	}
+
+	Stats GetStats() const;
+
+private:
+	void ReaderLoop();
+	void ParserLoop();
+	void DecoderLoop();
+	void SinkLoop();
+	void Fail(std::exception_ptr error);
+
+	// Push all of items, waiting while the queue is full. Returns false if the pipeline was stopped first.
+	template<typename Queue>
+	bool PushAll(Queue& queue, std::vector<DTC_EventHandle>& items);
+
+	Config config_;
+	Reader reader_;
+	Stage parser_;
+	Stage decoder_;
+	Sink sink_;
+
+	DTC_SPSCQueue<DTC_EventHandle> readQueue_;
+	DTC_MPMCQueue<DTC_EventHandle> parsedQueue_;
+	DTC_MPMCQueue<DTC_EventHandle> decodedQueue_;
+
+	std::atomic<bool> stop_{false};
+	std::atomic<bool> readerDone_{false};
+	std::atomic<bool> parserDone_{false};
+	std::atomic<size_t> decodersRunning_{0};
+
+	std::atomic<uint64_t> read_{0};
+	std::atomic<uint64_t> parsed_{0};
+	std::atomic<uint64_t> decoded_{0};
+	std::atomic<uint64_t> sunk_{0};
+	std::atomic<uint64_t> parseErrors_{0};
+	std::atomic<uint64_t> decodeErrors_{0};
+
+	std::mutex errorMutex_;
+	std::exception_ptr error_;
+	std::vector<std::thread> threads_;
+};
+
+}  // namespace DTCLib
+
+#endif  // artdaq_core_mu2e_Overlays_DTC_Packets_DTC_EventPipeline_h
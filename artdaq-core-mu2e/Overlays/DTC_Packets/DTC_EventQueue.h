@@ -0,0 +1,360 @@
+#ifndef artdaq_core_mu2e_Overlays_DTC_Packets_DTC_EventQueue_h
+#define artdaq_core_mu2e_Overlays_DTC_Packets_DTC_EventQueue_h
+
+#include "artdaq-core-mu2e/Overlays/DTC_Packets/DTC_Event.h"
+
+#include "artdaq-core-mu2e/Overlays/DTC_Types/DTC_BufferPool.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <thread>
+#include <utility>
+
+namespace DTCLib {
+
+/// <summary>
+/// Move-only handle to an event travelling through a pipeline: the DTC_Event (its parsed index of subevents and
+/// blocks) together with whatever keeps its buffer alive. A DTC_Event built on a DMA buffer only points into it, so
+/// the owner of that buffer travels with it, and is released when the handle is destroyed.
+/// </summary>
+class DTC_EventHandle
+{
+public:
+	/// <summary>
+	/// Construct an empty handle
+	/// </summary>
+	DTC_EventHandle() = default;
+	/// <summary>
+	/// Construct a handle
+	/// </summary>
+	/// <param name="event">Event, parsed or not</param>
+	/// <param name="buffer">Owner of the memory the event points into; nullptr if the event owns its buffer</param>
+	/// <param name="sequence">Sequence number, e.g. to restore the reading order after parallel stages</param>
+	explicit DTC_EventHandle(std::unique_ptr<DTC_Event> event, std::shared_ptr<const void> buffer = nullptr, uint64_t sequence = 0)
+		: event_(std::move(event)), buffer_(std::move(buffer)), sequence_(sequence) {}
+
+	DTC_EventHandle(DTC_EventHandle&&) = default;
+	DTC_EventHandle& operator=(DTC_EventHandle&&) = default;
+	DTC_EventHandle(DTC_EventHandle const&) = delete;
+	DTC_EventHandle& operator=(DTC_EventHandle const&) = delete;
+
+	/// <summary>
+	/// Create a handle overlaying an event in a buffer. SetupEvent is not called.
+	/// </summary>
+	/// <param name="data">Pointer to the DTC_EventHeader of the event</param>
+	/// <param name="buffer">Owner of the memory at data</param>
+	/// <param name="sequence">Sequence number</param>
+	static DTC_EventHandle Overlay(const void* data, std::shared_ptr<const void> buffer, uint64_t sequence = 0)
+	{
+		return DTC_EventHandle(std::unique_ptr<DTC_Event>(new DTC_Event(data)), std::move(buffer), sequence);
+	}
+	/// <summary>
+	/// Create a handle owning a copy of an event, e.g. so that a DMA buffer can be released immediately. SetupEvent is
+	/// not called.
+	/// </summary>
+	/// <param name="data">Pointer to the DTC_EventHeader of the event</param>
+	/// <param name="size">Number of bytes to copy</param>
+	/// <param name="sequence">Sequence number</param>
+	/// <param name="allocator">Allocator of the copy, nullptr for DTC_BufferAllocator::Default()</param>
+	static DTC_EventHandle Copy(const void* data, size_t size, uint64_t sequence = 0, DTC_BufferAllocator* allocator = nullptr)
+	{
+		std::unique_ptr<DTC_Event> event(new DTC_Event(size, allocator));
+		memcpy(const_cast<void*>(event->GetRawBufferPointer()), data, size);
+		return DTC_EventHandle(std::move(event), nullptr, sequence);
+	}
+
+	DTC_Event* get() const { return event_.get(); }
+	DTC_Event* operator->() const { return event_.get(); }
+	DTC_Event& operator*() const { return *event_; }
+	explicit operator bool() const { return event_ != nullptr; }
+
+	/// <summary>
+	/// Get the owner of the memory the event points into (nullptr if the event owns its buffer)
+	/// </summary>
+	std::shared_ptr<const void> const& GetBuffer() const { return buffer_; }
+	uint64_t GetSequence() const { return sequence_; }
+	void SetSequence(uint64_t sequence) { sequence_ = sequence; }
+
+private:
+	std::unique_ptr<DTC_Event> event_;
+	std::shared_ptr<const void> buffer_;
+	uint64_t sequence_{0};
+};
+
+/// <summary>
+/// Waiting strategy for a full or empty queue: yield for a while, then sleep, so that an idle stage does not keep a
+/// core busy
+/// </summary>
+class DTC_QueueBackoff
+{
+public:
+	void Pause()
+	{
+		if (count_ < kYields)
+		{
+			++count_;
+			std::this_thread::yield();
+		}
+		else
+		{
+			std::this_thread::sleep_for(std::chrono::microseconds(50));
+		}
+	}
+	void Reset() { count_ = 0; }
+
+private:
+	static constexpr unsigned kYields = 64;
+	unsigned count_{0};
+};
+
+/// <summary>
+/// Bounded lock-free single-producer, single-consumer ring queue of move-only items. The capacity is rounded up to a
+/// power of two. Each side caches the other side's index, so that an uncontended push or pop touches only its own
+/// cache line.
+///
+/// TryPush and PushBatch only move from items they accept; items refused because the queue is full are left as
+/// they were.
+/// </summary>
+template<typename T>
+class DTC_SPSCQueue
+{
+public:
+	explicit DTC_SPSCQueue(size_t capacity)
+		: mask_(RoundUpPow2(capacity) - 1), slots_(new Slot[mask_ + 1]) {}
+	~DTC_SPSCQueue()
+	{
+		for (auto pos = head_.load(std::memory_order_relaxed); pos != tail_.load(std::memory_order_relaxed); ++pos) item(pos)->~T();
+	}
+
+	DTC_SPSCQueue(DTC_SPSCQueue const&) = delete;
+	DTC_SPSCQueue& operator=(DTC_SPSCQueue const&) = delete;
+
+	/// <summary>
+	/// Push an item, if there is room (producer only)
+	/// </summary>
+	/// <returns>Whether the item was pushed</returns>
+	bool TryPush(T&& value) { return PushBatch(&value, 1) == 1; }
+	/// <summary>
+	/// Push as many items as there is room for, in order (producer only)
+	/// </summary>
+	/// <param name="values">Items to push</param>
+	/// <param name="count">Number of items</param>
+	/// <returns>Number of items pushed, from the front of values</returns>
+	size_t PushBatch(T* values, size_t count)
+	{
+		auto tail = tail_.load(std::memory_order_relaxed);
+		auto room = Capacity() - (tail - headCache_);
+		if (room < count)
+		{
+			headCache_ = head_.load(std::memory_order_acquire);
+			room = Capacity() - (tail - headCache_);
+		}
+		if (count > room) count = room;
+		for (size_t ii = 0; ii < count; ++ii) new (slot(tail + ii)) T(std::move(values[ii]));
+		tail_.store(tail + count, std::memory_order_release);
+		return count;
+	}
+
+	/// <summary>
+	/// Pop an item, if there is one (consumer only)
+	/// </summary>
+	/// <returns>Whether an item was popped into value</returns>
+	bool TryPop(T& value) { return PopBatch(&value, 1) == 1; }
+	/// <summary>
+	/// Pop up to max items, in order (consumer only)
+	/// </summary>
+	/// <returns>Number of items moved into values</returns>
+	size_t PopBatch(T* values, size_t max)
+	{
+		auto head = head_.load(std::memory_order_relaxed);
+		auto available = tailCache_ - head;
+		if (available < max)
+		{
+			tailCache_ = tail_.load(std::memory_order_acquire);
+			available = tailCache_ - head;
+		}
+		if (max > available) max = available;
+		for (size_t ii = 0; ii < max; ++ii)
+		{
+			auto ptr = item(head + ii);
+			values[ii] = std::move(*ptr);
+			ptr->~T();
+		}
+		head_.store(head + max, std::memory_order_release);
+		return max;
+	}
+
+	size_t Capacity() const { return mask_ + 1; }
+	/// <summary>
+	/// Get the number of items in the queue; only exact when neither side is active
+	/// </summary>
+	size_t SizeApprox() const { return tail_.load(std::memory_order_acquire) - head_.load(std::memory_order_acquire); }
+
+private:
+	struct Slot
+	{
+		alignas(T) unsigned char storage[sizeof(T)];
+	};
+
+	static size_t RoundUpPow2(size_t value)
+	{
+		size_t output = 1;
+		while (output < value) output <<= 1;
+		return output;
+	}
+	void* slot(size_t pos) { return slots_[pos & mask_].storage; }
+	T* item(size_t pos) { return std::launder(reinterpret_cast<T*>(slot(pos))); }
+
+	const size_t mask_;
+	std::unique_ptr<Slot[]> slots_;
+	alignas(64) std::atomic<size_t> head_{0};  ///< Next position to pop, written by the consumer
+	size_t tailCache_{0};                      ///< Consumer's copy of tail_
+	alignas(64) std::atomic<size_t> tail_{0};  ///< Next position to push, written by the producer
+	size_t headCache_{0};                      ///< Producer's copy of head_
+};
+
+/// <summary>
+/// Bounded lock-free multi-producer, multi-consumer ring queue of move-only items, after D. Vyukov's bounded MPMC
+/// queue: each cell carries a sequence number telling whether it is free or full for the current lap, so producers
+/// and consumers only contend on their own index. Batches claim several consecutive cells with a single
+/// compare-and-swap. The capacity is rounded up to a power of two.
+///
+/// TryPush and PushBatch only move from items they accept.
+/// </summary>
+template<typename T>
+class DTC_MPMCQueue
+{
+public:
+	explicit DTC_MPMCQueue(size_t capacity)
+		: mask_(RoundUpPow2(capacity) - 1), cells_(new Cell[mask_ + 1])
+	{
+		for (size_t ii = 0; ii <= mask_; ++ii) cells_[ii].sequence.store(ii, std::memory_order_relaxed);
+	}
+	~DTC_MPMCQueue()
+	{
+		for (auto pos = head_.load(std::memory_order_relaxed); pos != tail_.load(std::memory_order_relaxed); ++pos)
+		{
+			auto& cell = cells_[pos & mask_];
+			if (cell.sequence.load(std::memory_order_relaxed) == pos + 1) item(cell)->~T();
+		}
+	}
+
+	DTC_MPMCQueue(DTC_MPMCQueue const&) = delete;
+	DTC_MPMCQueue& operator=(DTC_MPMCQueue const&) = delete;
+
+	/// <summary>
+	/// Push an item, if there is room
+	/// </summary>
+	/// <returns>Whether the item was pushed</returns>
+	bool TryPush(T&& value) { return PushBatch(&value, 1) == 1; }
+	/// <summary>
+	/// Push as many items as there are consecutive free cells for, in order
+	/// </summary>
+	/// <returns>Number of items pushed, from the front of values</returns>
+	size_t PushBatch(T* values, size_t count)
+	{
+		size_t pos;
+		auto claimed = Claim(tail_, count, 0, pos);
+		for (size_t ii = 0; ii < claimed; ++ii)
+		{
+			auto& cell = cells_[(pos + ii) & mask_];
+			new (cell.storage) T(std::move(values[ii]));
+			cell.sequence.store(pos + ii + 1, std::memory_order_release);
+		}
+		return claimed;
+	}
+
+	/// <summary>
+	/// Pop an item, if there is one
+	/// </summary>
+	/// <returns>Whether an item was popped into value</returns>
+	bool TryPop(T& value) { return PopBatch(&value, 1) == 1; }
+	/// <summary>
+	/// Pop up to max consecutive items, in order
+	/// </summary>
+	/// <returns>Number of items moved into values</returns>
+	size_t PopBatch(T* values, size_t max)
+	{
+		size_t pos;
+		auto claimed = Claim(head_, max, 1, pos);
+		for (size_t ii = 0; ii < claimed; ++ii)
+		{
+			auto& cell = cells_[(pos + ii) & mask_];
+			auto ptr = item(cell);
+			values[ii] = std::move(*ptr);
+			ptr->~T();
+			cell.sequence.store(pos + ii + mask_ + 1, std::memory_order_release);
+		}
+		return claimed;
+	}
+
+	size_t Capacity() const { return mask_ + 1; }
+	/// <summary>
+	/// Get the number of items in the queue; only exact when no thread is active
+	/// </summary>
+	size_t SizeApprox() const
+	{
+		auto head = head_.load(std::memory_order_acquire);
+		auto tail = tail_.load(std::memory_order_acquire);
+		return tail > head ? tail - head : 0;
+	}
+
+private:
+	struct Cell
+	{
+		std::atomic<size_t> sequence;
+		alignas(T) unsigned char storage[sizeof(T)];
+	};
+
+	static size_t RoundUpPow2(size_t value)
+	{
+		size_t output = 1;
+		while (output < value) output <<= 1;
+		return output;
+	}
+	static T* item(Cell& cell) { return std::launder(reinterpret_cast<T*>(cell.storage)); }
+
+	// Claim up to max consecutive cells at index, which are ready when their sequence is position + offset
+	// (0: free, for producers; 1: full, for consumers). Returns the number claimed, and the first position.
+	size_t Claim(std::atomic<size_t>& index, size_t max, size_t offset, size_t& pos)
+	{
+		pos = index.load(std::memory_order_relaxed);
+		while (true)
+		{
+			size_t ready = 0;
+			while (ready < max)
+			{
+				auto sequence = cells_[(pos + ready) & mask_].sequence.load(std::memory_order_acquire);
+				auto diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos + ready + offset);
+				if (diff != 0)
+				{
+					// diff > 0: another thread already claimed this cell, and pos is stale
+					if (diff > 0 && ready == 0) ready = SIZE_MAX;
+					break;
+				}
+				++ready;
+			}
+			if (ready == SIZE_MAX)
+			{
+				pos = index.load(std::memory_order_relaxed);
+				continue;
+			}
+			if (ready == 0) return 0;
+			if (index.compare_exchange_weak(pos, pos + ready, std::memory_order_relaxed)) return ready;
+		}
+	}
+
+	const size_t mask_;
+	std::unique_ptr<Cell[]> cells_;
+	alignas(64) std::atomic<size_t> head_{0};  ///< Next position to pop
+	alignas(64) std::atomic<size_t> tail_{0};  ///< Next position to push
+};
+
+}  // namespace DTCLib
+
+#endif  // artdaq_core_mu2e_Overlays_DTC_Packets_DTC_EventQueue_h
@@ -0,0 +1,249 @@
+#include "artdaq-core-mu2e/Overlays/DTC_Packets/DTC_EventSkimmer.h"
+
+#include "artdaq-core-mu2e/Overlays/DTC_Packets/DTC_EventHeader.h"
+#include "artdaq-core-mu2e/Overlays/DTC_Packets/DTC_PacketViews.h"
+#include "artdaq-core-mu2e/Overlays/DTC_Packets/DTC_SubEvent.h"
+#include "artdaq-core-mu2e/Overlays/DTC_Packets/DTC_SubEventHeader.h"
+
+#include "artdaq-core-mu2e/Overlays/DTC_Types/Exceptions.h"
+
+#include "TRACE/tracemf.h"
+
+#include <cstring>
+
+namespace {
+constexpr size_t kPacketSize = 16;
+}
+
+DTCLib::DTC_EventSkimmer::Selection& DTCLib::DTC_EventSkimmer::Selection::Subsystems(std::initializer_list<DTC_Subsystem> list)
+{
+	subsystems = 0;
+	for (auto subsystem : list) subsystems |= 1 << (subsystem & 7);
+	return *this;
+}
+
+DTCLib::DTC_EventSkimmer::Selection& DTCLib::DTC_EventSkimmer::Selection::DTCs(std::initializer_list<uint8_t> list)
+{
+	dtcs.fill(0);
+	for (auto dtc : list) dtcs[dtc >> 6] |= 1ULL << (dtc & 63);
+	return *this;
+}
+
+DTCLib::DTC_EventSkimmer::Selection& DTCLib::DTC_EventSkimmer::Selection::Links(std::initializer_list<DTC_Link_ID> list)
+{
+	links = 0;
+	for (auto link : list) links |= 1 << (link & 7);
+	return *this;
+}
+
+DTCLib::DTC_EventSkimmer::DTC_EventSkimmer(Selection const& selection)
+	: selection_(selection)
+{}
+
+void DTCLib::DTC_EventSkimmer::AddSource(const uint8_t* source, size_t size)
+{
+	// Consecutive kept blocks become one segment
+	if (!pieces_.empty() && pieces_.back().source != nullptr && pieces_.back().source + pieces_.back().size == source)
+	{
+		pieces_.back().size += size;
+		return;
+	}
+	pieces_.push_back(Piece{source, 0, size});
+}
+
+size_t DTCLib::DTC_EventSkimmer::AddScratch(const void* source, size_t size)
+{
+	auto offset = scratch_.size();
+	scratch_.insert(scratch_.end(), static_cast<const uint8_t*>(source), static_cast<const uint8_t*>(source) + size);
+	if (!pieces_.empty() && pieces_.back().source == nullptr && pieces_.back().offset + pieces_.back().size == offset)
+	{
+		pieces_.back().size += size;
+	}
+	else
+	{
+		pieces_.push_back(Piece{nullptr, offset, size});
+	}
+	return offset;
+}
+
+size_t DTCLib::DTC_EventSkimmer::Plan(const void* data, size_t size)
+{
+	pieces_.clear();
+	scratch_.clear();
+	++events_;
+
+	auto ptr = static_cast<const uint8_t*>(data);
+	DTC_EventHeader header;
+	if (size < sizeof(header))
+	{
+		TLOG(TLVL_ERROR, "DTC_EventSkimmer") << "Buffer of " << size << " bytes is too small for a DTC_EventHeader";
+		throw DTC_WrongPacketSizeException(sizeof(header), size);
+	}
+	memcpy(&header, ptr, sizeof(header));
+	bytesIn_ += header.inclusive_event_byte_count;
+
+	size_t end = header.inclusive_event_byte_count;
+	if (end > size)
+	{
+		TLOG(TLVL_ERROR, "DTC_EventSkimmer") << "Event byte count " << end << " is larger than the buffer (" << size << " bytes), truncating the event";
+		end = size;
+	}
+
+	AddScratch(&header, sizeof(header));
+	size_t total = sizeof(header);
+	size_t subEvents = 0;
+	bool truncated = false;
+
+	size_t pos = sizeof(header);
+	while (pos < end)
+	{
+		DTC_SubEventHeader subHeader;
+		if (end - pos < sizeof(subHeader))
+		{
+			truncated = true;
+			break;
+		}
+		memcpy(&subHeader, ptr + pos, sizeof(subHeader));
+		size_t subEnd = pos + subHeader.inclusive_subevent_byte_count;
+		if (subHeader.subevent_format_version != DTC_SubEvent::REQUIRED_SUBEVENT_FORMAT_VERSION || subHeader.inclusive_subevent_byte_count < sizeof(subHeader) || subEnd > end)
+		{
+			truncated = true;
+			break;
+		}
+		if (!selection_.KeepDTC(subHeader.source_dtc_id))
+		{
+			pos = subEnd;
+			continue;
+		}
+
+		// Everything added for this subevent, so that it can be taken back if it keeps no block or is malformed
+		auto pieceMark = pieces_.size();
+		auto lastSize = pieces_.back().size;
+		auto subOffset = AddScratch(&subHeader, sizeof(subHeader));
+		size_t subBytes = sizeof(subHeader);
+		size_t rocs = 0;
+		size_t dropped = 0;  // Dropped blocks since the last kept one, starting at droppedPos
+		size_t droppedPos = 0;
+
+		auto blockPos = pos + sizeof(subHeader);
+		while (blockPos < subEnd)
+		{
+			DTC_DataHeaderView block(ptr + blockPos);
+			if (subEnd - blockPos < kPacketSize || !block.IsDataHeader() || !block.IsSizeConsistent() || blockPos + block.GetByteCount() > subEnd)
+			{
+				truncated = true;
+				break;
+			}
+			size_t bytes = block.GetByteCount();
+			if (!selection_.KeepSubsystem(block.GetSubsystemID()) || !selection_.KeepLink(block.GetLinkID()))
+			{
+				if (dropped++ == 0) droppedPos = blockPos;
+				blockPos += bytes;
+				continue;
+			}
+
+			// Keep the link positions of the following blocks with empty Data Headers
+			while (dropped > 0)
+			{
+				DTC_DataHeaderView droppedBlock(ptr + droppedPos);
+				uint8_t placeholder[kPacketSize];
+				memcpy(placeholder, ptr + droppedPos, kPacketSize);
+				placeholder[0] = kPacketSize;
+				placeholder[1] = 0;
+				placeholder[4] = 0;
+				placeholder[5] &= ~0x7;
+				AddScratch(placeholder, kPacketSize);
+				subBytes += kPacketSize;
+				++rocs;
+				droppedPos += droppedBlock.GetByteCount();
+				--dropped;
+			}
+			AddSource(ptr + blockPos, bytes);
+			subBytes += bytes;
+			++rocs;
+			blockPos += bytes;
+		}
+
+		if (truncated || rocs == 0)
+		{
+			pieces_.resize(pieceMark);
+			pieces_.back().size = lastSize;
+			scratch_.resize(subOffset);
+			if (truncated) break;
+		}
+		else
+		{
+			subHeader.inclusive_subevent_byte_count = subBytes;
+			subHeader.num_rocs = rocs;
+			memcpy(scratch_.data() + subOffset, &subHeader, sizeof(subHeader));
+			total += subBytes;
+			++subEvents;
+		}
+		pos = subEnd;
+	}
+
+	if (truncated)
+	{
+		++truncated_;
+		TLOG(TLVL_ERROR, "DTC_EventSkimmer") << "Malformed subevent at location 0x" << std::hex << pos << " / 0x" << header.inclusive_event_byte_count
+											 << " of event " << std::dec << header.event_tag_low << ", this event has been truncated";
+	}
+
+	header.inclusive_event_byte_count = total;
+	header.num_dtcs = subEvents;
+	memcpy(scratch_.data(), &header, sizeof(header));
+	bytesOut_ += total;
+	return total;
+}
+
+void DTCLib::DTC_EventSkimmer::Copy(uint8_t* output) const
+{
+	for (auto const& piece : pieces_)
+	{
+		memcpy(output, Resolve(piece), piece.size);
+		output += piece.size;
+	}
+}
+
+std::shared_ptr<DTCLib::DTC_Buffer> DTCLib::DTC_EventSkimmer::Skim(const void* data, size_t size, DTC_BufferAllocator* allocator)
+{
+	auto total = Plan(data, size);
+	auto output = DTC_Buffer::Make(total, allocator);
+	Copy(output->data());
+	return output;
+}
+
+DTCLib::DTC_Event DTCLib::DTC_EventSkimmer::Skim(DTC_Event const& event, DTC_BufferAllocator* allocator)
+{
+	// The header in the buffer is used, as the event's own copy is only filled by SetupEvent
+	DTC_EventHeader header;
+	memcpy(&header, event.GetRawBufferPointer(), sizeof(header));
+	auto total = Plan(event.GetRawBufferPointer(), header.inclusive_event_byte_count);
+	DTC_Event output(total, allocator);
+	Copy(static_cast<uint8_t*>(const_cast<void*>(output.GetRawBufferPointer())));
+	return output;
+}
+
+size_t DTCLib::DTC_EventSkimmer::SkimInto(const void* data, size_t size, void* output, size_t capacity)
+{
+	auto total = Plan(data, size);
+	if (total > capacity)
+	{
+		TLOG(TLVL_ERROR, "DTC_EventSkimmer") << "Skimmed event of " << total << " bytes does not fit in the output buffer of " << capacity << " bytes";
+		throw DTC_WrongPacketSizeException(capacity, total);
+	}
+	Copy(static_cast<uint8_t*>(output));
+	return total;
+}
+
+size_t DTCLib::DTC_EventSkimmer::Gather(const void* data, size_t size, std::vector<iovec>& segments)
+{
+	auto total = Plan(data, size);
+	segments.clear();
+	segments.reserve(pieces_.size());
+	for (auto const& piece : pieces_)
+	{
+		segments.push_back(iovec{const_cast<uint8_t*>(Resolve(piece)), piece.size});
+	}
+	return total;
+}
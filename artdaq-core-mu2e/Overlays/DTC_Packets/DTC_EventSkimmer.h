@@ -0,0 +1,136 @@
+#ifndef artdaq_core_mu2e_Overlays_DTC_Packets_DTC_EventSkimmer_h
+#define artdaq_core_mu2e_Overlays_DTC_Packets_DTC_EventSkimmer_h
+
+#include "artdaq-core-mu2e/Overlays/DTC_Packets/DTC_Event.h"
+
+#include "artdaq-core-mu2e/Overlays/DTC_Types/DTC_BufferPool.h"
+#include "artdaq-core-mu2e/Overlays/DTC_Types/DTC_Link_ID.h"
+#include "artdaq-core-mu2e/Overlays/DTC_Types/DTC_Subsystem.h"
+
+#include <sys/uio.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <memory>
+#include <vector>
+
+namespace DTCLib {
+
+/// <summary>
+/// Extracts the ROC blocks of selected subsystems, DTCs and links from a DTC_Event buffer into a new, valid
+/// DTC_Event buffer, e.g. for calibration streams. The input is walked once, header by header, without building a
+/// DTC_Event; the output is then written with one allocation and one memcpy per run of consecutive kept blocks, or
+/// returned as an iovec list for writev.
+///
+/// In the output, inclusive_event_byte_count, num_dtcs, inclusive_subevent_byte_count and num_rocs are updated.
+/// Subevents without any kept block are left out. DTC_SubEvent::SetupSubEvent requires the block of link N at
+/// position N, so a dropped block followed by a kept one of the same subevent is replaced by its 16-byte Data Header
+/// with a packet count of 0, as sent by a ROC without data; trailing dropped blocks are left out.
+///
+/// As in DTC_Event::SetupEvent, a malformed subevent truncates the event: it and the following subevents are left
+/// out, and an error is logged.
+/// </summary>
+class DTC_EventSkimmer
+{
+public:
+	/// <summary>
+	/// Blocks to keep: a block is kept if its subsystem, the DTC of its subevent and its link are all selected.
+	/// The default selection keeps everything.
+	/// </summary>
+	struct Selection
+	{
+		uint8_t subsystems{0xFF};                                ///< Bit N keeps blocks of DTC_Subsystem N
+		std::array<uint64_t, 4> dtcs{{~0ULL, ~0ULL, ~0ULL, ~0ULL}};  ///< Bit N keeps subevents of DTC ID N
+		uint8_t links{0xFF};                                     ///< Bit N keeps blocks of link N
+
+		/// <summary>
+		/// Keep only the given subsystems
+		/// </summary>
+		Selection& Subsystems(std::initializer_list<DTC_Subsystem> list);
+		/// <summary>
+		/// Keep only the given DTC IDs
+		/// </summary>
+		Selection& DTCs(std::initializer_list<uint8_t> list);
+		/// <summary>
+		/// Keep only the given links
+		/// </summary>
+		Selection& Links(std::initializer_list<DTC_Link_ID> list);
+
+		bool KeepSubsystem(uint8_t subsystem) const { return (subsystems >> (subsystem & 7)) & 1; }
+		bool KeepDTC(uint8_t dtc) const { return (dtcs[dtc >> 6] >> (dtc & 63)) & 1; }
+		bool KeepLink(uint8_t link) const { return (links >> (link & 7)) & 1; }
+	};
+
+	explicit DTC_EventSkimmer(Selection const& selection);
+
+	/// <summary>
+	/// Skim an event into a new buffer of exactly the output size
+	/// </summary>
+	/// <param name="data">Pointer to the DTC_EventHeader of the event</param>
+	/// <param name="size">Number of bytes available at data</param>
+	/// <param name="allocator">Allocator of the output, nullptr for DTC_BufferAllocator::Default()</param>
+	/// <returns>Buffer holding the skimmed event</returns>
+	std::shared_ptr<DTC_Buffer> Skim(const void* data, size_t size, DTC_BufferAllocator* allocator = nullptr);
+	/// <summary>
+	/// Skim an event into a new DTC_Event owning its buffer. The event is taken from its raw buffer, so SetupEvent
+	/// need not have been called on it; call SetupEvent on the result to index it.
+	/// </summary>
+	DTC_Event Skim(DTC_Event const& event, DTC_BufferAllocator* allocator = nullptr);
+	/// <summary>
+	/// Skim an event into a caller-provided buffer
+	/// </summary>
+	/// <param name="data">Pointer to the DTC_EventHeader of the event</param>
+	/// <param name="size">Number of bytes available at data</param>
+	/// <param name="output">Output buffer</param>
+	/// <param name="capacity">Size of the output buffer</param>
+	/// <returns>Number of bytes written</returns>
+	/// <exception cref="DTC_WrongPacketSizeException">The skimmed event does not fit in capacity</exception>
+	size_t SkimInto(const void* data, size_t size, void* output, size_t capacity);
+	/// <summary>
+	/// Plan the skim of an event as a list of segments to concatenate, without copying any block. Segments point
+	/// into the input buffer and into rewritten headers owned by the skimmer, and are valid until its next call.
+	/// </summary>
+	/// <param name="data">Pointer to the DTC_EventHeader of the event</param>
+	/// <param name="size">Number of bytes available at data</param>
+	/// <param name="segments">Segments of the skimmed event, replacing any previous contents</param>
+	/// <returns>Size of the skimmed event</returns>
+	size_t Gather(const void* data, size_t size, std::vector<iovec>& segments);
+
+	size_t GetEventCount() const { return events_; }
+	/// <summary>
+	/// Get the number of events truncated on a malformed subevent
+	/// </summary>
+	size_t GetTruncatedCount() const { return truncated_; }
+	size_t GetBytesIn() const { return bytesIn_; }
+	size_t GetBytesOut() const { return bytesOut_; }
+
+private:
+	// A segment of the output: size bytes at source, or at offset in scratch_ if source is nullptr
+	struct Piece
+	{
+		const uint8_t* source;
+		size_t offset;
+		size_t size;
+	};
+
+	size_t Plan(const void* data, size_t size);
+	void AddSource(const uint8_t* source, size_t size);
+	size_t AddScratch(const void* source, size_t size);
+	const uint8_t* Resolve(Piece const& piece) const { return piece.source != nullptr ? piece.source : scratch_.data() + piece.offset; }
+	void Copy(uint8_t* output) const;
+
+	Selection selection_;
+	std::vector<Piece> pieces_;
+	std::vector<uint8_t> scratch_;  ///< Rewritten event and subevent headers, and placeholder block headers
+
+	size_t events_{0};
+	size_t truncated_{0};
+	size_t bytesIn_{0};
+	size_t bytesOut_{0};
+};
+
+}  // namespace DTCLib
+
+#endif  // artdaq_core_mu2e_Overlays_DTC_Packets_DTC_EventSkimmer_h
@@ -0,0 +1,164 @@
+#include "artdaq-core-mu2e/Overlays/DTC_Packets/DTC_LatencyMonitor.h"
+
+#include "artdaq-core-mu2e/Overlays/DTC_Types/DTC_JSONWriter.h"
+
+#include "TRACE/tracemf.h"
+
+void DTCLib::DTC_LatencySketch::Merge(DTC_LatencySketch const& other)
+{
+	if (other.count == 0) return;
+	count += other.count;
+	sum += other.sum;
+	if (other.min < min) min = other.min;
+	if (other.max > max) max = other.max;
+	for (size_t ii = 0; ii < buckets.size(); ++ii) buckets[ii] += other.buckets[ii];
+}
+
+uint16_t DTCLib::DTC_LatencySketch::Quantile(double fraction) const
+{
+	if (count == 0) return 0;
+	auto target = static_cast<uint64_t>(fraction * count);
+	if (target >= count) target = count - 1;
+
+	uint64_t seen = 0;
+	size_t bucket = 0;
+	for (; bucket < buckets.size(); ++bucket)
+	{
+		seen += buckets[bucket];
+		if (seen > target) break;
+	}
+
+	uint32_t value = bucket;
+	if (bucket >= 2 * kSubBuckets)
+	{
+		auto shift = (bucket - 2 * kSubBuckets) / kSubBuckets + 1;
+		auto sub = (bucket - 2 * kSubBuckets) % kSubBuckets;
+		value = ((kSubBuckets + sub) << shift) + ((1U << shift) - 1) / 2;
+	}
+	if (value < min) value = min;
+	if (value > max) value = max;
+	return static_cast<uint16_t>(value);
+}
+
+DTCLib::DTC_LatencyMonitor::DTC_LatencyMonitor(Config const& config, clock::time_point now)
+	: config_(config), epochStart_(now)
+{
+	if (config_.epochs == 0) config_.epochs = 1;
+	if (config_.epoch.count() <= 0) config_.epoch = std::chrono::milliseconds(1);
+	TLOG(TLVL_DEBUG) << "DTC_LatencyMonitor window is " << config_.epochs << " epochs of " << config_.epoch.count() << " ms";
+}
+
+DTCLib::DTC_LatencyMonitor::~DTC_LatencyMonitor() = default;
+
+void DTCLib::DTC_LatencyMonitor::Advance(clock::time_point now)
+{
+	if (now < epochStart_ + config_.epoch) return;
+
+	auto elapsed = static_cast<size_t>((now - epochStart_) / config_.epoch);
+	epochStart_ += elapsed * config_.epoch;
+
+	// Clear each epoch being reused, at most the whole ring
+	auto clear = elapsed < config_.epochs ? elapsed : config_.epochs;
+	for (size_t ii = 0; ii < clear; ++ii)
+	{
+		current_ = (current_ + 1) % config_.epochs;
+		for (auto& dtc : dtcs_)
+		{
+			if (!dtc) continue;
+			for (auto& channel : (*dtc)[current_].channels) channel.Clear();
+		}
+	}
+	current_ = (current_ + elapsed - clear) % config_.epochs;
+}
+
+void DTCLib::DTC_LatencyMonitor::AddHeader(DTC_SubEventHeader const& header)
+{
+	auto& dtc = dtcs_[header.source_dtc_id];
+	if (!dtc) dtc.reset(new DTCState(config_.epochs));
+
+	auto& channels = (*dtc)[current_].channels;
+	channels[0].Add(header.link0_drp_rx_latency);
+	channels[1].Add(header.link1_drp_rx_latency);
+	channels[2].Add(header.link2_drp_rx_latency);
+	channels[3].Add(header.link3_drp_rx_latency);
+	channels[4].Add(header.link4_drp_rx_latency);
+	channels[5].Add(header.link5_drp_rx_latency);
+	channels[kLinkCount].Add(header.emtdc);
+}
+
+void DTCLib::DTC_LatencyMonitor::Add(DTC_SubEventHeader const& header, clock::time_point now)
+{
+	Advance(now);
+	AddHeader(header);
+}
+
+void DTCLib::DTC_LatencyMonitor::Add(DTC_Event const& event, clock::time_point now)
+{
+	Advance(now);
+	for (auto const& subEvent : event.GetSubEvents())
+	{
+		AddHeader(*subEvent.GetHeader());
+	}
+}
+
+DTCLib::DTC_LatencyMonitor::Snapshot DTCLib::DTC_LatencyMonitor::GetSnapshot(clock::time_point now)
+{
+	Advance(now);
+
+	Snapshot output;
+	for (size_t id = 0; id < dtcs_.size(); ++id)
+	{
+		if (!dtcs_[id]) continue;
+
+		std::array<DTC_LatencySketch, kChannels> window;
+		for (auto const& epoch : *dtcs_[id])
+		{
+			for (size_t ch = 0; ch < kChannels; ++ch) window[ch].Merge(epoch.channels[ch]);
+		}
+		if (window[0].count == 0) continue;
+
+		output.dtcs.emplace_back();
+		auto& summary = output.dtcs.back();
+		summary.dtcID = static_cast<uint8_t>(id);
+		for (size_t ch = 0; ch < kChannels; ++ch)
+		{
+			auto& out = ch < kLinkCount ? summary.links[ch] : summary.emtdc;
+			auto const& sketch = window[ch];
+			out.count = sketch.count;
+			out.min = sketch.min;
+			out.max = sketch.max;
+			out.mean = static_cast<double>(sketch.sum) / sketch.count;
+			out.p50 = sketch.Quantile(0.5);
+			out.p90 = sketch.Quantile(0.9);
+			out.p99 = sketch.Quantile(0.99);
+		}
+	}
+	return output;
+}
+
+std::string DTCLib::DTC_LatencyMonitor::Snapshot::toJSON() const
+{
+	std::string output;
+	DTC_JSONWriter writer(output);
+	auto appendChannel = [&](ChannelSummary const& ch) {
+		writer.Raw("[").Dec(ch.count).Raw(", ").Dec(ch.min).Raw(", ").Dec(ch.max).Raw(", ");
+		writer.Dec(static_cast<uint64_t>(ch.mean)).Raw(".").Dec(static_cast<uint64_t>((ch.mean - static_cast<uint64_t>(ch.mean)) * 100), 2);
+		writer.Raw(", ").Dec(ch.p50).Raw(", ").Dec(ch.p90).Raw(", ").Dec(ch.p99).Raw("]");
+	};
+
+	writer.BeginObject("DTC_LatencyMonitor");
+	for (auto const& dtc : dtcs)
+	{
+		writer.Key("DTC" + std::to_string(dtc.dtcID)).Raw("{ \"links\": [");
+		for (size_t link = 0; link < dtc.links.size(); ++link)
+		{
+			if (link > 0) writer.Raw(", ");
+			appendChannel(dtc.links[link]);
+		}
+		writer.Raw("], \"emtdc\": ");
+		appendChannel(dtc.emtdc);
+		writer.Raw(" }");
+	}
+	writer.EndObject();
+	return output;
+}
@@ -0,0 +1,159 @@
+#ifndef artdaq_core_mu2e_Overlays_DTC_Packets_DTC_LatencyMonitor_h
+#define artdaq_core_mu2e_Overlays_DTC_Packets_DTC_LatencyMonitor_h
+
+#include "artdaq-core-mu2e/Overlays/DTC_Packets/DTC_Event.h"
+#include "artdaq-core-mu2e/Overlays/DTC_Packets/DTC_SubEvent.h"
+#include "artdaq-core-mu2e/Overlays/DTC_Packets/DTC_SubEventHeader.h"
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace DTCLib {
+
+/// <summary>
+/// Log-linear histogram of 16-bit values, in the style of HDR histograms: values below 64 have their own bucket,
+/// larger values share a bucket with values within 1/32 (about 3%) of them. Quantiles are therefore exact below 64 and
+/// within 3% above.
+/// </summary>
+struct DTC_LatencySketch
+{
+	static constexpr size_t kSubBuckets = 32;
+	static constexpr size_t kBuckets = 2 * kSubBuckets + 10 * kSubBuckets;  ///< Exact range, then one row per octave up to 2^16
+
+	uint64_t count{0};
+	uint64_t sum{0};
+	uint16_t min{0xFFFF};
+	uint16_t max{0};
+	std::array<uint32_t, kBuckets> buckets{};
+
+	static size_t Bucket(uint16_t value)
+	{
+		if (value < 2 * kSubBuckets) return value;
+		size_t msb = 31 - __builtin_clz(value);  // 6..15
+		return 2 * kSubBuckets + (msb - 6) * kSubBuckets + ((value >> (msb - 5)) & (kSubBuckets - 1));
+	}
+
+	void Add(uint16_t value)
+	{
+		++count;
+		sum += value;
+		if (value < min) min = value;
+		if (value > max) max = value;
+		++buckets[Bucket(value)];
+	}
+
+	void Merge(DTC_LatencySketch const& other);
+	void Clear() { *this = DTC_LatencySketch(); }
+
+	/// <summary>
+	/// Get a quantile, as the midpoint of the bucket containing it, clamped to [min, max]
+	/// </summary>
+	/// <param name="fraction">Quantile, between 0 and 1 (e.g. 0.99)</param>
+	/// <returns>Value of the quantile, 0 if the sketch is empty</returns>
+	uint16_t Quantile(double fraction) const;
+};
+
+/// <summary>
+/// Streaming aggregator of the link latency fields of DTC subevent headers. For every subevent, the six
+/// linkN_drp_rx_latency values and emtdc are read straight from the header and added to per-DTC sketches; the
+/// subevent data is not touched. Sketches are kept per time epoch, and a snapshot summarizes the sliding window of the
+/// last Config::epochs epochs: per DTC and link, count, min, max, mean and the 50%, 90% and 99% quantiles.
+///
+/// DTC_LatencyMonitor is not thread-safe; use one instance per thread and merge the snapshots, or serialize access.
+/// </summary>
+class DTC_LatencyMonitor
+{
+public:
+	using clock = std::chrono::steady_clock;
+
+	struct Config
+	{
+		std::chrono::milliseconds epoch{1000};  ///< Duration of one epoch
+		size_t epochs{10};                       ///< Number of epochs in the sliding window
+	};
+
+	static constexpr size_t kLinkCount = 6;
+	static constexpr size_t kChannels = kLinkCount + 1;  ///< drp_rx_latency of each link, then emtdc
+
+	/// <summary>
+	/// Summary of one latency value over the window
+	/// </summary>
+	struct ChannelSummary
+	{
+		uint64_t count{0};
+		uint16_t min{0};
+		uint16_t max{0};
+		double mean{0};
+		uint16_t p50{0};
+		uint16_t p90{0};
+		uint16_t p99{0};
+	};
+
+	/// <summary>
+	/// Summary of one DTC over the window
+	/// </summary>
+	struct DTCSummary
+	{
+		uint8_t dtcID{0};
+		std::array<ChannelSummary, kLinkCount> links;  ///< linkN_drp_rx_latency
+		ChannelSummary emtdc;
+	};
+
+	/// <summary>
+	/// Summaries of all DTCs with data in the window, sorted by DTC ID
+	/// </summary>
+	struct Snapshot
+	{
+		std::vector<DTCSummary> dtcs;
+
+		/// <summary>
+		/// Serialize the snapshot as a compact JSON object: per DTC, one [count, min, max, mean, p50, p90, p99] array per
+		/// link and for emtdc
+		/// </summary>
+		std::string toJSON() const;
+	};
+
+	explicit DTC_LatencyMonitor(Config const& config, clock::time_point now = clock::now());
+	~DTC_LatencyMonitor();
+
+	/// <summary>
+	/// Add the latency fields of one subevent header
+	/// </summary>
+	/// <param name="header">Subevent header, e.g. in place in a DMA buffer</param>
+	/// <param name="now">Arrival time, used to assign the subevent to an epoch</param>
+	void Add(DTC_SubEventHeader const& header, clock::time_point now = clock::now());
+	void Add(DTC_SubEvent const& subEvent, clock::time_point now = clock::now()) { Add(*subEvent.GetHeader(), now); }
+	/// <summary>
+	/// Add the latency fields of every subevent of an event
+	/// </summary>
+	void Add(DTC_Event const& event, clock::time_point now = clock::now());
+
+	/// <summary>
+	/// Summarize the sliding window ending at the given time
+	/// </summary>
+	Snapshot GetSnapshot(clock::time_point now = clock::now());
+
+private:
+	struct Epoch
+	{
+		std::array<DTC_LatencySketch, kChannels> channels;
+	};
+	using DTCState = std::vector<Epoch>;  ///< One Epoch per slot of the ring
+
+	void Advance(clock::time_point now);
+	void AddHeader(DTC_SubEventHeader const& header);
+
+	Config config_;
+	size_t current_{0};              ///< Ring slot of the current epoch
+	clock::time_point epochStart_;  ///< Start of the current epoch
+	std::array<std::unique_ptr<DTCState>, 256> dtcs_;  ///< Allocated when a DTC is first seen
+};
+
+}  // namespace DTCLib
+
+#endif  // artdaq_core_mu2e_Overlays_DTC_Packets_DTC_LatencyMonitor_h
@@ -0,0 +1,157 @@
+#include "artdaq-core-mu2e/Overlays/DTC_Packets/DTC_LinkStatistics.h"
+
+#include <algorithm>
+
+std::atomic<DTCLib::DTC_LinkStatistics*> DTCLib::DTC_LinkStatistics::active_{nullptr};
+
+namespace {
+// Count the set bits of a status byte; status bytes are mostly zero, so only set bits are visited
+void countBits(std::array<std::atomic<uint64_t>, 8>& counters, uint8_t status)
+{
+	while (status != 0)
+	{
+		counters[__builtin_ctz(status)].fetch_add(1, std::memory_order_relaxed);
+		status &= status - 1;
+	}
+}
+
+template<typename T, size_t N>
+void load(std::array<uint64_t, N>& output, std::array<std::atomic<T>, N> const& input)
+{
+	for (size_t ii = 0; ii < N; ++ii) output[ii] = input[ii].load(std::memory_order_relaxed);
+}
+}  // namespace
+
+DTCLib::DTC_LinkCounters& DTCLib::DTC_LinkCounters::operator+=(DTC_LinkCounters const& other)
+{
+	blocks += other.blocks;
+	bytes += other.bytes;
+	packets += other.packets;
+	for (size_t ii = 0; ii < blockStatus.size(); ++ii) blockStatus[ii] += other.blockStatus[ii];
+	for (size_t ii = 0; ii < linkStatus.size(); ++ii) linkStatus[ii] += other.linkStatus[ii];
+	linkIDMismatches += other.linkIDMismatches;
+	ewtMismatches += other.ewtMismatches;
+	sizeErrors += other.sizeErrors;
+	typeErrors += other.typeErrors;
+	return *this;
+}
+
+DTCLib::DTC_LinkCounters& DTCLib::DTC_LinkCounters::operator-=(DTC_LinkCounters const& other)
+{
+	blocks -= other.blocks;
+	bytes -= other.bytes;
+	packets -= other.packets;
+	for (size_t ii = 0; ii < blockStatus.size(); ++ii) blockStatus[ii] -= other.blockStatus[ii];
+	for (size_t ii = 0; ii < linkStatus.size(); ++ii) linkStatus[ii] -= other.linkStatus[ii];
+	linkIDMismatches -= other.linkIDMismatches;
+	ewtMismatches -= other.ewtMismatches;
+	sizeErrors -= other.sizeErrors;
+	typeErrors -= other.typeErrors;
+	return *this;
+}
+
+DTCLib::DTC_DTCCounters& DTCLib::DTC_DTCCounters::operator+=(DTC_DTCCounters const& other)
+{
+	subEvents += other.subEvents;
+	formatErrors += other.formatErrors;
+	truncations += other.truncations;
+	for (size_t ii = 0; ii < links.size(); ++ii) links[ii] += other.links[ii];
+	return *this;
+}
+
+DTCLib::DTC_DTCCounters& DTCLib::DTC_DTCCounters::operator-=(DTC_DTCCounters const& other)
+{
+	subEvents -= other.subEvents;
+	formatErrors -= other.formatErrors;
+	truncations -= other.truncations;
+	for (size_t ii = 0; ii < links.size(); ++ii) links[ii] -= other.links[ii];
+	return *this;
+}
+
+DTCLib::DTC_DTCCounters const* DTCLib::DTC_LinkStatisticsSnapshot::Find(uint8_t dtcID) const
+{
+	auto it = std::lower_bound(dtcs.begin(), dtcs.end(), dtcID, [](DTC_DTCCounters const& dtc, uint8_t id) { return dtc.dtcID < id; });
+	if (it == dtcs.end() || it->dtcID != dtcID) return nullptr;
+	return &*it;
+}
+
+DTCLib::DTC_LinkStatisticsSnapshot DTCLib::DTC_LinkStatisticsSnapshot::operator-(DTC_LinkStatisticsSnapshot const& earlier) const
+{
+	// DTCs are never removed, so every DTC of the earlier snapshot is also in this one
+	DTC_LinkStatisticsSnapshot output(*this);
+	for (auto& dtc : output.dtcs)
+	{
+		auto previous = earlier.Find(dtc.dtcID);
+		if (previous != nullptr) dtc -= *previous;
+	}
+	return output;
+}
+
+DTCLib::DTC_LinkStatistics::DTC_LinkStatistics()
+	: dtcs_(new std::array<AtomicDTCCounters, 256>()) {}
+
+DTCLib::DTC_LinkStatistics::~DTC_LinkStatistics()
+{
+	// Stop the parser from recording into a destroyed object
+	DTC_LinkStatistics* self = this;
+	active_.compare_exchange_strong(self, nullptr);
+}
+
+void DTCLib::DTC_LinkStatistics::RecordSubEvent(DTC_SubEventHeader const& header)
+{
+	auto dtcID = static_cast<uint8_t>(header.source_dtc_id);
+	auto& slot = Slot(dtcID);
+	Bump(dtcID, slot.subEvents);
+	countBits(slot.links[0].linkStatus, header.link0_status);
+	countBits(slot.links[1].linkStatus, header.link1_status);
+	countBits(slot.links[2].linkStatus, header.link2_status);
+	countBits(slot.links[3].linkStatus, header.link3_status);
+	countBits(slot.links[4].linkStatus, header.link4_status);
+	countBits(slot.links[5].linkStatus, header.link5_status);
+}
+
+void DTCLib::DTC_LinkStatistics::RecordBlock(uint8_t dtcID, uint8_t link, uint64_t bytes, uint64_t packets, uint8_t status)
+{
+	auto& counters = Slot(dtcID).links[link & 7];
+	Bump(dtcID, counters.blocks);
+	counters.bytes.fetch_add(bytes, std::memory_order_relaxed);
+	counters.packets.fetch_add(packets, std::memory_order_relaxed);
+	countBits(counters.blockStatus, status);
+}
+
+DTCLib::DTC_LinkStatisticsSnapshot DTCLib::DTC_LinkStatistics::Snapshot() const
+{
+	DTC_LinkStatisticsSnapshot output;
+	for (size_t word = 0; word < seen_.size(); ++word)
+	{
+		auto mask = seen_[word].load(std::memory_order_relaxed);
+		while (mask != 0)
+		{
+			auto dtcID = static_cast<uint8_t>(word * 64 + __builtin_ctzll(mask));
+			mask &= mask - 1;
+
+			auto const& slot = (*dtcs_)[dtcID];
+			output.dtcs.emplace_back();
+			auto& dtc = output.dtcs.back();
+			dtc.dtcID = dtcID;
+			dtc.subEvents = slot.subEvents.load(std::memory_order_relaxed);
+			dtc.formatErrors = slot.formatErrors.load(std::memory_order_relaxed);
+			dtc.truncations = slot.truncations.load(std::memory_order_relaxed);
+			for (size_t link = 0; link < slot.links.size(); ++link)
+			{
+				auto const& in = slot.links[link];
+				auto& out = dtc.links[link];
+				out.blocks = in.blocks.load(std::memory_order_relaxed);
+				out.bytes = in.bytes.load(std::memory_order_relaxed);
+				out.packets = in.packets.load(std::memory_order_relaxed);
+				load(out.blockStatus, in.blockStatus);
+				load(out.linkStatus, in.linkStatus);
+				out.linkIDMismatches = in.linkIDMismatches.load(std::memory_order_relaxed);
+				out.ewtMismatches = in.ewtMismatches.load(std::memory_order_relaxed);
+				out.sizeErrors = in.sizeErrors.load(std::memory_order_relaxed);
+				out.typeErrors = in.typeErrors.load(std::memory_order_relaxed);
+			}
+		}
+	}
+	return output;
+}
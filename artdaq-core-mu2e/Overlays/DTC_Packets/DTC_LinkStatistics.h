@@ -0,0 +1,165 @@
+#ifndef artdaq_core_mu2e_Overlays_DTC_Packets_DTC_LinkStatistics_h
+#define artdaq_core_mu2e_Overlays_DTC_Packets_DTC_LinkStatistics_h
+
+#include "artdaq-core-mu2e/Overlays/DTC_Packets/DTC_SubEventHeader.h"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace DTCLib {
+
+/// <summary>
+/// Data-quality counters of one DTC link
+/// </summary>
+struct DTC_LinkCounters
+{
+	uint64_t blocks{0};                       ///< ROC data blocks
+	uint64_t bytes{0};                        ///< Bytes in ROC data blocks, including the Data Header packet
+	uint64_t packets{0};                      ///< Data packets, from the Data Header packet count
+	std::array<uint64_t, 8> blockStatus{};    ///< Blocks with each bit of the Data Header status byte set (see DTC_DataStatus.h)
+	std::array<uint64_t, 8> linkStatus{};     ///< Subevents with each bit of the subevent header linkN_status set
+	uint64_t linkIDMismatches{0};             ///< Blocks whose link ID did not match their position in the subevent
+	uint64_t ewtMismatches{0};                ///< Blocks whose Event Window Tag did not match the subevent
+	uint64_t sizeErrors{0};                   ///< Blocks whose byte count did not match their packet count
+	uint64_t typeErrors{0};                   ///< Blocks which did not start with a Data Header packet
+
+	DTC_LinkCounters& operator+=(DTC_LinkCounters const& other);
+	DTC_LinkCounters& operator-=(DTC_LinkCounters const& other);
+
+	/// <summary>
+	/// Total number of link ID, EWT, size and packet type errors
+	/// </summary>
+	uint64_t Errors() const { return linkIDMismatches + ewtMismatches + sizeErrors + typeErrors; }
+};
+
+/// <summary>
+/// Data-quality counters of one DTC and its links
+/// </summary>
+struct DTC_DTCCounters
+{
+	static constexpr size_t kLinkCount = 8;  ///< Every value of the 3-bit link ID
+
+	uint8_t dtcID{0};
+	uint64_t subEvents{0};                           ///< Subevents set up
+	uint64_t formatErrors{0};                        ///< Subevents with an unsupported format version
+	uint64_t truncations{0};                         ///< Events truncated at a subevent of this DTC
+	std::array<DTC_LinkCounters, kLinkCount> links;  ///< Counters by link ID
+
+	DTC_DTCCounters& operator+=(DTC_DTCCounters const& other);
+	DTC_DTCCounters& operator-=(DTC_DTCCounters const& other);
+};
+
+/// <summary>
+/// Counters of all DTCs which have been seen, sorted by DTC ID
+/// </summary>
+struct DTC_LinkStatisticsSnapshot
+{
+	std::vector<DTC_DTCCounters> dtcs;
+
+	/// <summary>
+	/// Find the counters of a DTC
+	/// </summary>
+	/// <returns>Pointer to the counters, nullptr if the DTC has not been seen</returns>
+	DTC_DTCCounters const* Find(uint8_t dtcID) const;
+
+	/// <summary>
+	/// Get the counters accumulated since an earlier snapshot
+	/// </summary>
+	DTC_LinkStatisticsSnapshot operator-(DTC_LinkStatisticsSnapshot const& earlier) const;
+};
+
+/// <summary>
+/// Lock-free accumulator of per-DTC and per-link data-quality statistics, filled by DTC_SubEvent::SetupSubEvent and
+/// DTC_Event::SetupEvent while they parse. Counters are relaxed atomics in a fixed table indexed by DTC ID and link,
+/// so any number of threads can record concurrently. Snapshot() only copies the DTCs which have been seen.
+///
+/// Parsing records into the statistics installed with SetActive; nothing is recorded while none is installed.
+/// </summary>
+class DTC_LinkStatistics
+{
+public:
+	DTC_LinkStatistics();
+	~DTC_LinkStatistics();
+
+	DTC_LinkStatistics(DTC_LinkStatistics const&) = delete;
+	DTC_LinkStatistics& operator=(DTC_LinkStatistics const&) = delete;
+
+	/// <summary>
+	/// Install the statistics updated by the parser. The object must outlive all parsing, or be uninstalled first.
+	/// </summary>
+	/// <param name="stats">Statistics to update, nullptr to stop recording</param>
+	static void SetActive(DTC_LinkStatistics* stats) { active_.store(stats, std::memory_order_release); }
+	/// <summary>
+	/// Get the statistics updated by the parser
+	/// </summary>
+	/// <returns>Installed statistics, nullptr if none</returns>
+	static DTC_LinkStatistics* Active() { return active_.load(std::memory_order_acquire); }
+
+	/// <summary>
+	/// Record a subevent header: counts the subevent, and the linkN_status bits of each of its links
+	/// </summary>
+	void RecordSubEvent(DTC_SubEventHeader const& header);
+	/// <summary>
+	/// Record a ROC data block
+	/// </summary>
+	void RecordBlock(uint8_t dtcID, uint8_t link, uint64_t bytes, uint64_t packets, uint8_t status);
+	void RecordLinkIDMismatch(uint8_t dtcID, uint8_t link) { Bump(dtcID, Slot(dtcID).links[link & 7].linkIDMismatches); }
+	void RecordEWTMismatch(uint8_t dtcID, uint8_t link) { Bump(dtcID, Slot(dtcID).links[link & 7].ewtMismatches); }
+	void RecordSizeError(uint8_t dtcID, uint8_t link) { Bump(dtcID, Slot(dtcID).links[link & 7].sizeErrors); }
+	void RecordTypeError(uint8_t dtcID, uint8_t link) { Bump(dtcID, Slot(dtcID).links[link & 7].typeErrors); }
+	void RecordFormatError(uint8_t dtcID) { Bump(dtcID, Slot(dtcID).formatErrors); }
+	void RecordTruncation(uint8_t dtcID) { Bump(dtcID, Slot(dtcID).truncations); }
+
+	/// <summary>
+	/// Copy the counters of every DTC which has been seen. Each counter is read atomically, but counters recorded
+	/// concurrently with the snapshot may or may not be included.
+	/// </summary>
+	DTC_LinkStatisticsSnapshot Snapshot() const;
+
+private:
+	struct AtomicLinkCounters
+	{
+		std::atomic<uint64_t> blocks{0};
+		std::atomic<uint64_t> bytes{0};
+		std::atomic<uint64_t> packets{0};
+		std::array<std::atomic<uint64_t>, 8> blockStatus{};
+		std::array<std::atomic<uint64_t>, 8> linkStatus{};
+		std::atomic<uint64_t> linkIDMismatches{0};
+		std::atomic<uint64_t> ewtMismatches{0};
+		std::atomic<uint64_t> sizeErrors{0};
+		std::atomic<uint64_t> typeErrors{0};
+	};
+	struct AtomicDTCCounters
+	{
+		std::atomic<uint64_t> subEvents{0};
+		std::atomic<uint64_t> formatErrors{0};
+		std::atomic<uint64_t> truncations{0};
+		std::array<AtomicLinkCounters, DTC_DTCCounters::kLinkCount> links;
+	};
+
+	AtomicDTCCounters& Slot(uint8_t dtcID) { return (*dtcs_)[dtcID]; }
+	void Bump(uint8_t dtcID, std::atomic<uint64_t>& counter, uint64_t value = 1)
+	{
+		MarkSeen(dtcID);
+		counter.fetch_add(value, std::memory_order_relaxed);
+	}
+	void MarkSeen(uint8_t dtcID)
+	{
+		auto& word = seen_[dtcID >> 6];
+		auto bit = 1ULL << (dtcID & 63);
+		if ((word.load(std::memory_order_relaxed) & bit) == 0) word.fetch_or(bit, std::memory_order_relaxed);
+	}
+
+	static std::atomic<DTC_LinkStatistics*> active_;
+
+	std::unique_ptr<std::array<AtomicDTCCounters, 256>> dtcs_;
+	std::array<std::atomic<uint64_t>, 4> seen_{};  ///< Bit mask of the DTC IDs which have been recorded
+};
+
+}  // namespace DTCLib
+
+#endif  // artdaq_core_mu2e_Overlays_DTC_Packets_DTC_LinkStatistics_h
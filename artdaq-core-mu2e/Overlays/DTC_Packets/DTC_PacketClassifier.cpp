@@ -0,0 +1,204 @@
+#include "artdaq-core-mu2e/Overlays/DTC_Packets/DTC_PacketClassifier.h"
+
+#include "TRACE/tracemf.h"
+
+#include <cstring>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace {
+void resetMask(DTCLib::DTC_PacketClassification::Mask& mask, size_t words) { mask.assign(words, 0); }
+
+// Number of packets in the block started by a packet: Data Headers span their byte count, DCS Replies their Block
+// Read packets (as in DTC_DCSReplyView), everything else one packet
+size_t blockSpan(const uint8_t* packet)
+{
+	auto type = packet[2] >> 4;
+	if (type == DTCLib::DTC_PacketType_DataHeader)
+	{
+		size_t span = (packet[0] + (packet[1] << 8)) / 16;
+		return span == 0 ? 1 : span;
+	}
+	if (type == DTCLib::DTC_PacketType_DCSReply) return 1 + (packet[4] >> 6) + (packet[5] << 2);
+	return 1;
+}
+}  // namespace
+
+DTCLib::DTC_PacketClassification::Mask const& DTCLib::DTC_PacketClassification::Get(DTC_PacketType type) const
+{
+	static const Mask none;
+	switch (type)
+	{
+		case DTC_PacketType_DataHeader:
+			return dataHeaders;
+		case DTC_PacketType_Heartbeat:
+			return heartbeats;
+		case DTC_PacketType_DataRequest:
+			return dataRequests;
+		case DTC_PacketType_DCSRequest:
+			return dcsRequests;
+		case DTC_PacketType_DCSReply:
+			return dcsReplies;
+		default:
+			return none;
+	}
+}
+
+size_t DTCLib::DTC_PacketClassification::Count(Mask const& mask)
+{
+	size_t count = 0;
+	for (auto word : mask) count += __builtin_popcountll(word);
+	return count;
+}
+
+DTCLib::DTC_PacketClassification::Mask DTCLib::DTC_PacketClassification::And(Mask const& a, Mask const& b)
+{
+	Mask output(a.size() < b.size() ? a.size() : b.size());
+	for (size_t ii = 0; ii < output.size(); ++ii) output[ii] = a[ii] & b[ii];
+	return output;
+}
+
+DTCLib::DTC_PacketClassification::Mask DTCLib::DTC_PacketClassification::LinkMask(uint8_t link) const
+{
+	Mask output(starts.size(), 0);
+	for (size_t ii = 0; ii < packetCount; ++ii)
+	{
+		if (links[ii] == link) output[ii >> 6] |= 1ULL << (ii & 63);
+	}
+	return output;
+}
+
+void DTCLib::DTC_PacketClassifier::Classify(const void* buffer, size_t size, DTC_PacketClassification& output)
+{
+	auto ptr = static_cast<const uint8_t*>(buffer);
+	auto n = size / 16;
+	auto words = (n + 63) / 64;
+
+	output.packetCount = n;
+	output.truncated = false;
+	output.types.resize(n);
+	output.links.resize(n);
+	output.byteCounts.resize(n);
+	resetMask(output.valid, words);
+	resetMask(output.starts, words);
+	resetMask(output.dataHeaders, words);
+	resetMask(output.heartbeats, words);
+	resetMask(output.dataRequests, words);
+	resetMask(output.dcsRequests, words);
+	resetMask(output.dcsReplies, words);
+	resetMask(output.invalid, words);
+
+	// Packets which, if they start a block, start one longer than a packet
+	auto& multi = output.invalid;  // Scratch until the last step
+
+	// Pass 1: decode the DMA header of every packet. Type masks are accumulated for all packets here, and limited
+	// to block starts once those are known.
+	size_t ii = 0;
+#if defined(__SSE2__)
+	auto const nibble = _mm_set1_epi32(0xF);
+	auto const linkBits = _mm_set1_epi32(0x7);
+	auto const lowWord = _mm_set1_epi32(0xFFFF);
+	auto const bias32 = _mm_set1_epi32(0x8000);
+	auto const bias16 = _mm_set1_epi16(static_cast<int16_t>(0x8000));
+	auto const onePacket = _mm_set1_epi32(16);
+	auto const blockReadCount = _mm_set1_epi32(0x3FF << 6);
+	auto typeMask = [&](__m128i types, int type) {
+		return static_cast<uint64_t>(_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(types, _mm_set1_epi32(type)))));
+	};
+	for (; ii + 4 <= n; ii += 4)
+	{
+		auto p = reinterpret_cast<const __m128i*>(ptr + 16 * ii);
+		auto ab = _mm_unpacklo_epi32(_mm_loadu_si128(p), _mm_loadu_si128(p + 1));
+		auto cd = _mm_unpacklo_epi32(_mm_loadu_si128(p + 2), _mm_loadu_si128(p + 3));
+		auto header = _mm_unpacklo_epi64(ab, cd);  // Bytes 0-3 of the four packets
+		auto header1 = _mm_unpackhi_epi64(ab, cd);  // Bytes 4-7
+
+		auto types = _mm_and_si128(_mm_srli_epi32(header, 20), nibble);
+		auto links = _mm_and_si128(_mm_srli_epi32(header, 24), linkBits);
+		auto counts = _mm_and_si128(header, lowWord);
+
+		// Narrow to bytes: types in bytes 0-3, links in bytes 4-7
+		auto narrow = _mm_packus_epi16(_mm_packs_epi32(types, links), _mm_setzero_si128());
+		auto typeBytes = _mm_cvtsi128_si32(narrow);
+		auto linkBytes = _mm_cvtsi128_si32(_mm_srli_si128(narrow, 4));
+		memcpy(output.types.data() + ii, &typeBytes, 4);
+		memcpy(output.links.data() + ii, &linkBytes, 4);
+		// Byte counts are unsigned 16-bit; bias them so that the signed saturating pack is exact
+		auto packedCounts = _mm_xor_si128(_mm_packs_epi32(_mm_sub_epi32(counts, bias32), _mm_setzero_si128()), bias16);
+		_mm_storel_epi64(reinterpret_cast<__m128i*>(output.byteCounts.data() + ii), packedCounts);
+
+		// ii is a multiple of 4, so the four bits never straddle two words
+		auto word = ii >> 6;
+		auto shift = ii & 63;
+		output.valid[word] |= static_cast<uint64_t>(_mm_movemask_ps(_mm_castsi128_ps(header))) << shift;  // Valid is bit 31
+		auto dataHeaders = typeMask(types, DTC_PacketType_DataHeader);
+		auto dcsReplies = typeMask(types, DTC_PacketType_DCSReply);
+		output.dataHeaders[word] |= dataHeaders << shift;
+		output.heartbeats[word] |= typeMask(types, DTC_PacketType_Heartbeat) << shift;
+		output.dataRequests[word] |= typeMask(types, DTC_PacketType_DataRequest) << shift;
+		output.dcsRequests[word] |= typeMask(types, DTC_PacketType_DCSRequest) << shift;
+		output.dcsReplies[word] |= dcsReplies << shift;
+
+		auto longBlock = static_cast<uint64_t>(_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpgt_epi32(counts, onePacket))));
+		auto blockRead = static_cast<uint64_t>(_mm_movemask_ps(_mm_castsi128_ps(
+			_mm_xor_si128(_mm_cmpeq_epi32(_mm_and_si128(header1, blockReadCount), _mm_setzero_si128()), _mm_set1_epi32(-1)))));
+		multi[word] |= ((dataHeaders & longBlock) | (dcsReplies & blockRead)) << shift;
+	}
+#endif
+	for (; ii < n; ++ii)
+	{
+		auto packet = ptr + 16 * ii;
+		auto type = static_cast<uint8_t>(packet[2] >> 4);
+		output.types[ii] = type;
+		output.links[ii] = packet[3] & 0x7;
+		output.byteCounts[ii] = packet[0] + (packet[1] << 8);
+
+		auto bit = 1ULL << (ii & 63);
+		auto word = ii >> 6;
+		if ((packet[3] & 0x80) != 0) output.valid[word] |= bit;
+		if (type == DTC_PacketType_DataHeader) output.dataHeaders[word] |= bit;
+		if (type == DTC_PacketType_Heartbeat) output.heartbeats[word] |= bit;
+		if (type == DTC_PacketType_DataRequest) output.dataRequests[word] |= bit;
+		if (type == DTC_PacketType_DCSRequest) output.dcsRequests[word] |= bit;
+		if (type == DTC_PacketType_DCSReply) output.dcsReplies[word] |= bit;
+		if (blockSpan(packet) > 1) multi[word] |= bit;
+	}
+
+	// Pass 2: find block starts. Between multi-packet blocks every packet starts a block, so whole runs are set at
+	// once, and only the multi-packet block headers are visited.
+	size_t packet = 0;
+	while (packet < n)
+	{
+		auto word = packet >> 6;
+		auto fromHere = ~0ULL << (packet & 63);
+		auto next = multi[word] & fromHere;
+		if (next == 0)
+		{
+			output.starts[word] |= fromHere;
+			packet = (word + 1) * 64 < n ? (word + 1) * 64 : n;
+			continue;
+		}
+		auto header = word * 64 + __builtin_ctzll(next);
+		output.starts[word] |= fromHere & (~0ULL >> (63 - (header & 63)));  // packet .. header inclusive
+		packet = header + blockSpan(ptr + 16 * header);
+	}
+	if (n % 64 != 0 && words > 0) output.starts[words - 1] &= ~0ULL >> (64 - n % 64);
+	if (packet > n)
+	{
+		output.truncated = true;
+		TLOG(TLVL_DEBUG + 5) << "Last block of the buffer extends " << (packet - n) << " packets past its end";
+	}
+
+	for (size_t word = 0; word < words; ++word)
+	{
+		auto starts = output.starts[word];
+		output.dataHeaders[word] &= starts;
+		output.heartbeats[word] &= starts;
+		output.dataRequests[word] &= starts;
+		output.dcsRequests[word] &= starts;
+		output.dcsReplies[word] &= starts;
+		output.invalid[word] = starts & ~output.valid[word];
+	}
+}
@@ -0,0 +1,107 @@
+#ifndef artdaq_core_mu2e_Overlays_DTC_Packets_DTC_PacketClassifier_h
+#define artdaq_core_mu2e_Overlays_DTC_Packets_DTC_PacketClassifier_h
+
+#include "artdaq-core-mu2e/Overlays/DTC_Packets/DTC_PacketType.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace DTCLib {
+
+/// <summary>
+/// Per-packet decode of a DMA buffer of 16-byte packets, as filled by DTC_PacketClassifier::Classify.
+///
+/// types, links, byteCounts and valid are the DMA header fields of every packet in the buffer, whether or not the
+/// packet starts a block: payload packets following a Data Header or a Block Read DCS Reply decode as garbage.
+/// starts marks the packets which start a block, found by following the Data Header byte counts and DCS Reply
+/// Block Read packet counts from the first packet; the per-type masks are limited to those packets.
+///
+/// Masks hold one bit per packet, packet N in bit N % 64 of word N / 64.
+/// </summary>
+struct DTC_PacketClassification
+{
+	using Mask = std::vector<uint64_t>;
+
+	size_t packetCount{0};           ///< Number of whole packets in the buffer
+	bool truncated{false};           ///< Whether the last block extends past the end of the buffer
+	std::vector<uint8_t> types;      ///< Packet type nibble of each packet (see DTC_PacketType)
+	std::vector<uint8_t> links;      ///< Link ID of each packet
+	std::vector<uint16_t> byteCounts;  ///< Block byte count of each packet
+
+	Mask valid;         ///< Packets with the valid bit set
+	Mask starts;        ///< Packets which start a block
+	Mask dataHeaders;   ///< Block starts of type Data Header
+	Mask heartbeats;    ///< Block starts of type Heartbeat
+	Mask dataRequests;  ///< Block starts of type Data Request
+	Mask dcsRequests;   ///< Block starts of type DCS Request
+	Mask dcsReplies;    ///< Block starts of type DCS Reply
+	Mask invalid;       ///< Block starts without the valid bit
+
+	/// <summary>
+	/// Get the mask of block starts of the given type
+	/// </summary>
+	Mask const& Get(DTC_PacketType type) const;
+
+	/// <summary>
+	/// Whether a packet is set in a mask
+	/// </summary>
+	static bool Test(Mask const& mask, size_t packet) { return (mask[packet >> 6] >> (packet & 63)) & 1; }
+	/// <summary>
+	/// Count the packets set in a mask
+	/// </summary>
+	static size_t Count(Mask const& mask);
+	/// <summary>
+	/// Combine two masks, e.g. dcsReplies and the links of interest
+	/// </summary>
+	static Mask And(Mask const& a, Mask const& b);
+	/// <summary>
+	/// Get the mask of packets of the given link
+	/// </summary>
+	Mask LinkMask(uint8_t link) const;
+
+	/// <summary>
+	/// Call f(packetIndex) for each packet set in a mask, in order
+	/// </summary>
+	template<typename F>
+	static void ForEach(Mask const& mask, F&& f)
+	{
+		for (size_t word = 0; word < mask.size(); ++word)
+		{
+			auto bits = mask[word];
+			while (bits != 0)
+			{
+				f(word * 64 + __builtin_ctzll(bits));
+				bits &= bits - 1;
+			}
+		}
+	}
+};
+
+/// <summary>
+/// Decodes the DMA headers of a whole buffer of 16-byte packets in one pass, four packets at a time with SSE2 where
+/// available, instead of constructing a DTC_DMAPacket per packet. Demultiplexing mixed DCS and data traffic is then
+/// mask arithmetic on the DTC_PacketClassification.
+/// </summary>
+class DTC_PacketClassifier
+{
+public:
+	/// <summary>
+	/// Classify the packets of a buffer
+	/// </summary>
+	/// <param name="buffer">Pointer to the first packet (after any DMA transfer byte count)</param>
+	/// <param name="size">Number of bytes available in buffer; a trailing partial packet is ignored</param>
+	/// <param name="output">Classification to fill. Its vectors are reused, so that classifying buffers in a loop
+	/// does not allocate.</param>
+	static void Classify(const void* buffer, size_t size, DTC_PacketClassification& output);
+	static DTC_PacketClassification Classify(const void* buffer, size_t size)
+	{
+		DTC_PacketClassification output;
+		Classify(buffer, size, output);
+		return output;
+	}
+};
+
+}  // namespace DTCLib
+
+#endif  // artdaq_core_mu2e_Overlays_DTC_Packets_DTC_PacketClassifier_h
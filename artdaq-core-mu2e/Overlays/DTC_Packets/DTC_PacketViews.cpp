@@ -0,0 +1,29 @@
+#include "artdaq-core-mu2e/Overlays/DTC_Packets/DTC_PacketViews.h"
+
+#include "artdaq-core-mu2e/Overlays/DTC_Packets/DTC_DataPacket.h"
+#include "artdaq-core-mu2e/Overlays/DTC_Types/DTC_Instrumentation.h"
+#include "artdaq-core-mu2e/Overlays/DTC_Types/Exceptions.h"
+
+#include "TRACE/tracemf.h"
+
+void DTCLib::DTC_DataHeaderView::Validate() const
+{
+	DTC_INSTRUMENT_SCOPE(timer, HeaderDecode);
+	DTC_INSTRUMENT_ADD(timer, 16, 1);
+	if (!IsDataHeader())
+	{
+		auto ex = DTC_WrongPacketTypeException(DTC_PacketType_DataHeader, GetPacketType());
+		TLOG(TLVL_ERROR) << "Unexpected packet type encountered: " + std::to_string(GetPacketType()) + " != " + std::to_string(DTC_PacketType_DataHeader) +
+			" (expected)";
+		TLOG(TLVL_ERROR) << "Packet contents: " << DTC_DataPacket(data_).toJSON();
+		throw ex;
+	}
+	if (!IsSizeConsistent())
+	{
+		auto ex = DTC_WrongPacketSizeException((GetPacketCount() + 1) * 16, GetByteCount());
+		TLOG(TLVL_ERROR) << "Unexpected packet size encountered: " + std::to_string((GetPacketCount() + 1) * 16) + " != " + std::to_string(GetByteCount()) +
+			" (expected)";
+		TLOG(TLVL_DEBUG) << "Packet contents: " << DTC_DataPacket(data_).toJSON();
+		throw ex;
+	}
+}
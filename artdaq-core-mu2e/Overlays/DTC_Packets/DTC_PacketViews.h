@@ -0,0 +1,274 @@
+#ifndef artdaq_core_mu2e_Overlays_DTC_Packets_DTC_PacketViews_h
+#define artdaq_core_mu2e_Overlays_DTC_Packets_DTC_PacketViews_h
+
+#include "artdaq-core-mu2e/Overlays/DTC_Packets/DTC_DCSReplyView.h"
+#include "artdaq-core-mu2e/Overlays/DTC_Packets/DTC_PacketType.h"
+
+#include "artdaq-core-mu2e/Overlays/DTC_Types/DTC_DCSOperationType.h"
+#include "artdaq-core-mu2e/Overlays/DTC_Types/DTC_DebugType.h"
+#include "artdaq-core-mu2e/Overlays/DTC_Types/DTC_EWT.h"
+#include "artdaq-core-mu2e/Overlays/DTC_Types/DTC_EventMode.h"
+#include "artdaq-core-mu2e/Overlays/DTC_Types/DTC_EventWindowTag.h"
+#include "artdaq-core-mu2e/Overlays/DTC_Types/DTC_Link_ID.h"
+#include "artdaq-core-mu2e/Overlays/DTC_Types/DTC_Subsystem.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace DTCLib {
+
+/// <summary>
+/// Read-only overlay of the DMA header of a 16-byte DTC packet in place in memory. Unlike DTC_DMAPacket, the view is
+/// a single pointer: it is trivially copyable, has no virtual functions, and decodes each field when it is read.
+/// The packet type is not checked; the memory must hold at least 16 bytes and outlive the view.
+/// Multi-byte fields are little-endian, as on the DTC.
+/// </summary>
+class DTC_DMAPacketView
+{
+public:
+	/// <summary>
+	/// Construct an empty (invalid) view
+	/// </summary>
+	DTC_DMAPacketView() = default;
+	/// <summary>
+	/// Overlay a view on the given packet
+	/// </summary>
+	/// <param name="data">Pointer to the first byte of the packet</param>
+	explicit DTC_DMAPacketView(const void* data)
+		: data_(static_cast<const uint8_t*>(data)) {}
+
+	/// <summary>
+	/// Get the pointer to the first byte of the packet
+	/// </summary>
+	const uint8_t* GetData() const { return data_; }
+
+	/// <summary>
+	/// Get the block byte count
+	/// </summary>
+	uint16_t GetByteCount() const { return word(0); }
+	/// <summary>
+	/// Get the valid bit
+	/// </summary>
+	bool isValid() const { return (data_[3] & 0x80) == 0x80; }
+	/// <summary>
+	/// Get the Subsystem ID (Data Header packets only)
+	/// </summary>
+	uint8_t GetSubsystemID() const { return (data_[5] >> 5) & 0x7; }
+	/// <summary>
+	/// Get the Link ID of the packet
+	/// </summary>
+	DTC_Link_ID GetLinkID() const { return static_cast<DTC_Link_ID>(data_[3] & 0x7); }
+	/// <summary>
+	/// Get the packet type
+	/// </summary>
+	DTC_PacketType GetPacketType() const { return static_cast<DTC_PacketType>(data_[2] >> 4); }
+	/// <summary>
+	/// Get the hop count
+	/// </summary>
+	uint8_t GetHopCount() const { return data_[2] & 0xF; }
+
+protected:
+	uint16_t word(size_t byte) const { return data_[byte] + (data_[byte + 1] << 8); }
+
+	const uint8_t* data_{nullptr};
+};
+
+/// <summary>
+/// Read-only overlay of a Data Header packet, decoded as in DTC_DataHeaderPacket
+/// </summary>
+class DTC_DataHeaderView : public DTC_DMAPacketView
+{
+public:
+	DTC_DataHeaderView() = default;
+	explicit DTC_DataHeaderView(const void* data)
+		: DTC_DMAPacketView(data) {}
+
+	/// <summary>
+	/// Whether the packet type is Data Header
+	/// </summary>
+	bool IsDataHeader() const { return GetPacketType() == DTC_PacketType_DataHeader; }
+	/// <summary>
+	/// Whether the block byte count matches the packet count, as required by DTC_DataHeaderPacket
+	/// </summary>
+	bool IsSizeConsistent() const { return (GetPacketCount() + 1) * 16 == GetByteCount(); }
+	/// <summary>
+	/// Throw the exception DTC_DataHeaderPacket would throw if the packet is not a well-formed Data Header
+	/// </summary>
+	/// <exception cref="DTC_WrongPacketTypeException">The packet type is not Data Header</exception>
+	/// <exception cref="DTC_WrongPacketSizeException">The byte count does not match the packet count</exception>
+	void Validate() const;
+
+	/// <summary>
+	/// Get the Subsystem of the Data Block
+	/// </summary>
+	DTC_Subsystem GetSubsystem() const { return static_cast<DTC_Subsystem>(GetSubsystemID()); }
+	/// <summary>
+	/// Get the number of Data Packets in the Data Block
+	/// </summary>
+	uint16_t GetPacketCount() const { return data_[4] + ((data_[5] & 7) << 8); }
+	/// <summary>
+	/// Get the Event Window Tag of the Data Block
+	/// </summary>
+	DTC_EWT GetEWT() const { return DTC_EWT::LoadLE(data_ + 6); }
+	DTC_EventWindowTag GetEventWindowTag() const { return DTC_EventWindowTag(GetEWT()); }
+	/// <summary>
+	/// Get the Data Status of the Data Block
+	/// </summary>
+	uint8_t GetStatus() const { return data_[12]; }
+	/// <summary>
+	/// Get the Data Packet Version identifier
+	/// </summary>
+	uint8_t GetVersion() const { return data_[13]; }
+	/// <summary>
+	/// Get the DTC ID of the Data Block
+	/// </summary>
+	uint8_t GetID() const { return data_[14]; }
+	/// <summary>
+	/// Get the EVB Mode word
+	/// </summary>
+	uint8_t GetEVBMode() const { return data_[15]; }
+};
+
+/// <summary>
+/// Read-only overlay of a Heartbeat packet, decoded as in DTC_HeartbeatPacket
+/// </summary>
+class DTC_HeartbeatView : public DTC_DMAPacketView
+{
+public:
+	DTC_HeartbeatView() = default;
+	explicit DTC_HeartbeatView(const void* data)
+		: DTC_DMAPacketView(data) {}
+
+	/// <summary>
+	/// Whether the packet type is Heartbeat
+	/// </summary>
+	bool IsHeartbeat() const { return GetPacketType() == DTC_PacketType_Heartbeat; }
+
+	/// <summary>
+	/// Get the Event Window Tag of the Heartbeat
+	/// </summary>
+	DTC_EWT GetEWT() const { return DTC_EWT::LoadLE(data_ + 4); }
+	DTC_EventWindowTag GetEventWindowTag() const { return DTC_EventWindowTag(GetEWT()); }
+	/// <summary>
+	/// Get the Mode bytes of the Heartbeat
+	/// </summary>
+	DTC_EventMode GetEventMode() const
+	{
+		DTC_EventMode mode;
+		mode.mode0 = data_[10];
+		mode.mode1 = data_[11];
+		mode.mode2 = data_[12];
+		mode.mode3 = data_[13];
+		mode.mode4 = data_[14];
+		return mode;
+	}
+	/// <summary>
+	/// Get the Delivery Ring TDC byte
+	/// </summary>
+	uint8_t GetDeliveryRingTDC() const { return data_[15]; }
+};
+
+/// <summary>
+/// Read-only overlay of a Data Request packet, decoded as in DTC_DataRequestPacket
+/// </summary>
+class DTC_DataRequestView : public DTC_DMAPacketView
+{
+public:
+	DTC_DataRequestView() = default;
+	explicit DTC_DataRequestView(const void* data)
+		: DTC_DMAPacketView(data) {}
+
+	/// <summary>
+	/// Whether the packet type is Data Request
+	/// </summary>
+	bool IsDataRequest() const { return GetPacketType() == DTC_PacketType_DataRequest; }
+
+	/// <summary>
+	/// Get the Event Window Tag requested
+	/// </summary>
+	DTC_EWT GetEWT() const { return DTC_EWT::LoadLE(data_ + 4); }
+	DTC_EventWindowTag GetEventWindowTag() const { return DTC_EventWindowTag(GetEWT()); }
+	/// <summary>
+	/// Get the debug flag
+	/// </summary>
+	bool GetDebug() const { return (data_[12] & 0x1) == 1; }
+	/// <summary>
+	/// Get the debug type
+	/// </summary>
+	DTC_DebugType GetDebugType() const { return static_cast<DTC_DebugType>((data_[12] & 0xF0) >> 4); }
+	/// <summary>
+	/// Get the number of packets requested in debug mode
+	/// </summary>
+	uint16_t GetDebugPacketCount() const { return word(14); }
+};
+
+/// <summary>
+/// Read-only overlay of a DCS Request packet, decoded as in DTC_DCSRequestPacket. Block Write words which continue
+/// into following packets are not covered; use DTC_DCSRequestPacket for those.
+/// </summary>
+class DTC_DCSRequestView : public DTC_DMAPacketView
+{
+public:
+	DTC_DCSRequestView() = default;
+	explicit DTC_DCSRequestView(const void* data)
+		: DTC_DMAPacketView(data) {}
+
+	/// <summary>
+	/// Whether the packet type is DCS Request
+	/// </summary>
+	bool IsDCSRequest() const { return GetPacketType() == DTC_PacketType_DCSRequest; }
+
+	/// <summary>
+	/// Get the DCS Operation Type, including the double operation bit
+	/// </summary>
+	DTC_DCSOperationType GetType() const { return static_cast<DTC_DCSOperationType>(data_[4] & 0x7); }
+	/// <summary>
+	/// Whether the request is a double operation
+	/// </summary>
+	bool IsDoubleOp() const { return (data_[4] & 0x4) != 0; }
+	/// <summary>
+	/// Whether an acknowledgment is requested
+	/// </summary>
+	bool RequestsAck() const { return (data_[4] & 0x8) == 0x8; }
+	/// <summary>
+	/// Whether the address is incremented during Block operations
+	/// </summary>
+	bool IncrementsAddress() const { return (data_[4] & 0x10) == 0x10; }
+	/// <summary>
+	/// Get the number of Block Write packets following this packet
+	/// </summary>
+	uint16_t GetPacketCount() const { return (data_[4] >> 6) + (data_[5] << 2); }
+	/// <summary>
+	/// Get the first address
+	/// </summary>
+	uint16_t GetAddress1() const { return word(6); }
+	/// <summary>
+	/// Get the first data word (the word count, for Block Write)
+	/// </summary>
+	uint16_t GetData1() const { return word(8); }
+	/// <summary>
+	/// Get the second address (0 for Block Write)
+	/// </summary>
+	uint16_t GetAddress2() const { return GetType() == DTC_DCSOperationType_BlockWrite ? 0 : word(10); }
+	/// <summary>
+	/// Get the second data word (0 for Block Write)
+	/// </summary>
+	uint16_t GetData2() const { return GetType() == DTC_DCSOperationType_BlockWrite ? 0 : word(12); }
+	/// <summary>
+	/// Get one of the three Block Write words carried in this packet
+	/// </summary>
+	/// <param name="idx">Word index, 0 to 2</param>
+	uint16_t GetBlockWriteWord(size_t idx) const { return word(10 + 2 * idx); }
+};
+
+static_assert(std::is_trivially_copyable<DTC_DMAPacketView>::value, "Packet views must be trivially copyable");
+static_assert(std::is_trivially_copyable<DTC_DataHeaderView>::value, "Packet views must be trivially copyable");
+static_assert(std::is_trivially_copyable<DTC_HeartbeatView>::value, "Packet views must be trivially copyable");
+static_assert(std::is_trivially_copyable<DTC_DataRequestView>::value, "Packet views must be trivially copyable");
+static_assert(std::is_trivially_copyable<DTC_DCSRequestView>::value, "Packet views must be trivially copyable");
+static_assert(std::is_trivially_copyable<DTC_DCSReplyView>::value, "Packet views must be trivially copyable");
+
+}  // namespace DTCLib
+
+#endif  // artdaq_core_mu2e_Overlays_DTC_Packets_DTC_PacketViews_h
@@ -4,6 +4,7 @@
 #include "artdaq-core-mu2e/Overlays/DTC_Packets/DTC_DataBlock.h"
 #include "artdaq-core-mu2e/Overlays/DTC_Packets/DTC_SubEventHeader.h"
 
+#include "artdaq-core-mu2e/Overlays/DTC_Types/DTC_BufferPool.h"
 #include "artdaq-core-mu2e/Overlays/DTC_Types/DTC_EventMode.h"
 #include "artdaq-core-mu2e/Overlays/DTC_Types/DTC_EventWindowTag.h"
 #include "artdaq-core-mu2e/Overlays/DTC_Types/DTC_Subsystem.h"
@@ -24,7 +25,12 @@ public:
 	/// </summary>
 	/// <param name="ptr">Pointer to data</param>
 	explicit DTC_SubEvent(const void* data);
-	explicit DTC_SubEvent(size_t data_size);
+	/// <summary>
+	/// Construct a DTC_SubEvent which owns an uninitialized buffer of the given size
+	/// </summary>
+	/// <param name="data_size">Size of the buffer, in bytes</param>
+	/// <param name="allocator">Allocator of the buffer, nullptr for DTC_BufferAllocator::Default()</param>
+	explicit DTC_SubEvent(size_t data_size, DTC_BufferAllocator* allocator = nullptr);
 
 	DTC_SubEvent()
 		: header_(), data_blocks_(), buffer_ptr_(nullptr) {}
@@ -51,10 +57,10 @@ public:
 	}
 	void AddDataBlock(DTC_DataBlock blk)
 	{
-		auto block_id = blk.GetHeader()->GetLinkID();
+		auto block_id = blk.GetHeaderView().GetLinkID();
 		auto insert_iter = data_blocks_.begin();
         while (insert_iter != data_blocks_.end()) {
-			if (block_id < insert_iter->GetHeader()->GetLinkID()) break;
+			if (block_id < insert_iter->GetHeaderView().GetLinkID()) break;
 			++insert_iter;
         }
 		data_blocks_.insert(insert_iter, blk);
@@ -103,7 +109,7 @@ public:
 	void UpdateHeader();
 
 private:
-	std::shared_ptr<std::vector<uint8_t>> allocBytes{nullptr};  ///< Used if the block owns its memory
+	std::shared_ptr<DTC_Buffer> allocBytes{nullptr};  ///< Used if the block owns its memory
 	DTC_SubEventHeader header_;
 	std::vector<DTC_DataBlock> data_blocks_;
 	const void* buffer_ptr_;
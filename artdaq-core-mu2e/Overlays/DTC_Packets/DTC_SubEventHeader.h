@@ -1,6 +1,8 @@
 #ifndef artdaq_core_mu2e_Overlays_DTC_Packets_DTC_SubEventHeader_h
 #define artdaq_core_mu2e_Overlays_DTC_Packets_DTC_SubEventHeader_h
 
+#include "artdaq-core-mu2e/Overlays/DTC_Types/DTC_JSONWriter.h"
+
 #include <cstdint>
 #include <iomanip>
 #include <sstream>
@@ -89,41 +91,49 @@ struct DTC_SubEventHeader
 
 	inline std::string toJson() const
 	{
-		std::ostringstream oss;
-
-		oss << "\"DTC_SubEventHeader\": {\n";
-		oss << "\t\"inclusive_subevent_byte_count\": " << inclusive_subevent_byte_count;
-		oss << ",\n\t\"event_tag_low\": " << event_tag_low;
-		oss << ",\n\t\"event_tag_high\": " << event_tag_high;
-		oss << ",\n\t\"num_rocs\": " << num_rocs;
-		oss << ",\n\t\"event_mode\": 0x" << std::hex << event_mode << std::dec;
-		oss << ",\n\t\"dtc_mac\": " << dtc_mac;
-		oss << ",\n\t\"partition_id\": " << partition_id;
-		oss << ",\n\t\"evb_mode\": " << evb_mode;
-		oss << ",\n\t\"source_dtc_id\": " << source_dtc_id;
-		oss << ",\n\t\"link0_subsystem\": " << link0_subsystem;
-		oss << ",\n\t\"link1_subsystem\": " << link1_subsystem;
-		oss << ",\n\t\"link2_subsystem\": " << link2_subsystem;
-		oss << ",\n\t\"link3_subsystem\": " << link3_subsystem;
-		oss << ",\n\t\"link4_subsystem\": " << link4_subsystem;
-		oss << ",\n\t\"link5_subsystem\": " << link5_subsystem;
-		oss << ",\n\t\"link0_status\": " << link0_status;
-		oss << ",\n\t\"link1_status\": " << link1_status;
-		oss << ",\n\t\"link2_status\": " << link2_status;
-		oss << ",\n\t\"link3_status\": " << link3_status;
-		oss << ",\n\t\"link4_status\": " << link4_status;
-		oss << ",\n\t\"link5_status\": " << link5_status;
-		oss << ",\n\t\"subevent_format_version\": " << subevent_format_version;
-		oss << ",\n\t\"emtdc\": " << emtdc;
-		oss << ",\n\t\"link0_drp_rx_latency\": " << link0_drp_rx_latency;
-		oss << ",\n\t\"link1_drp_rx_latency\": " << link1_drp_rx_latency;
-		oss << ",\n\t\"link2_drp_rx_latency\": " << link2_drp_rx_latency;
-		oss << ",\n\t\"link3_drp_rx_latency\": " << link3_drp_rx_latency;
-		oss << ",\n\t\"link4_drp_rx_latency\": " << link4_drp_rx_latency;
-		oss << ",\n\t\"link5_drp_rx_latency\": " << link5_drp_rx_latency;
-		oss << "\n}";
-
-		return oss.str();
+		std::string output;
+		AppendJson(output);
+		return output;
+	}
+
+	/// <summary>
+	/// Append the JSON representation (see toJson()) to a string
+	/// </summary>
+	/// <param name="output">String to append to</param>
+	inline void AppendJson(std::string& output) const
+	{
+		DTC_JSONWriter writer(output);
+		writer.BeginObject("DTC_SubEventHeader");
+		writer.Field("inclusive_subevent_byte_count", inclusive_subevent_byte_count);
+		writer.Field("event_tag_low", event_tag_low);
+		writer.Field("event_tag_high", event_tag_high);
+		writer.Field("num_rocs", num_rocs);
+		writer.HexField("event_mode", event_mode);
+		writer.Field("dtc_mac", dtc_mac);
+		writer.Field("partition_id", partition_id);
+		writer.Field("evb_mode", evb_mode);
+		writer.Field("source_dtc_id", source_dtc_id);
+		writer.Field("link0_subsystem", link0_subsystem);
+		writer.Field("link1_subsystem", link1_subsystem);
+		writer.Field("link2_subsystem", link2_subsystem);
+		writer.Field("link3_subsystem", link3_subsystem);
+		writer.Field("link4_subsystem", link4_subsystem);
+		writer.Field("link5_subsystem", link5_subsystem);
+		writer.Field("link0_status", link0_status);
+		writer.Field("link1_status", link1_status);
+		writer.Field("link2_status", link2_status);
+		writer.Field("link3_status", link3_status);
+		writer.Field("link4_status", link4_status);
+		writer.Field("link5_status", link5_status);
+		writer.Field("subevent_format_version", subevent_format_version);
+		writer.Field("emtdc", emtdc);
+		writer.Field("link0_drp_rx_latency", link0_drp_rx_latency);
+		writer.Field("link1_drp_rx_latency", link1_drp_rx_latency);
+		writer.Field("link2_drp_rx_latency", link2_drp_rx_latency);
+		writer.Field("link3_drp_rx_latency", link3_drp_rx_latency);
+		writer.Field("link4_drp_rx_latency", link4_drp_rx_latency);
+		writer.Field("link5_drp_rx_latency", link5_drp_rx_latency);
+		writer.EndObject();
 	}
 };
 
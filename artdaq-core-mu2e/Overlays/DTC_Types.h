@@ -1,5 +1,6 @@
 #pragma message "DTC_Types.h is deprecated, please update to use artdaq-core-mu2e/Overlays/DTC_Types/*.h"
 
+#include "artdaq-core-mu2e/Overlays/DTC_Types/DTC_BufferPool.h"
 #include "artdaq-core-mu2e/Overlays/DTC_Types/DTC_CharacterNotInTableError.h"
 #include "artdaq-core-mu2e/Overlays/DTC_Types/DTC_DCSOperationType.h"
 #include "artdaq-core-mu2e/Overlays/DTC_Types/DTC_DDRFlags.h"
@@ -7,9 +8,13 @@
 #include "artdaq-core-mu2e/Overlays/DTC_Types/DTC_EVBStatus.h"
 #include "artdaq-core-mu2e/Overlays/DTC_Types/DTC_EventMode.h"
 #include "artdaq-core-mu2e/Overlays/DTC_Types/DTC_EventWindowTag.h"
+#include "artdaq-core-mu2e/Overlays/DTC_Types/DTC_EWT.h"
 #include "artdaq-core-mu2e/Overlays/DTC_Types/DTC_FIFOFullErrorFlags.h"
+#include "artdaq-core-mu2e/Overlays/DTC_Types/DTC_HexDump.h"
 #include "artdaq-core-mu2e/Overlays/DTC_Types/DTC_IICDDRBusAddress.h"
 #include "artdaq-core-mu2e/Overlays/DTC_Types/DTC_IICSERDESBusAddress.h"
+#include "artdaq-core-mu2e/Overlays/DTC_Types/DTC_Instrumentation.h"
+#include "artdaq-core-mu2e/Overlays/DTC_Types/DTC_JSONWriter.h"
 #include "artdaq-core-mu2e/Overlays/DTC_Types/DTC_LinkEnableMode.h"
 #include "artdaq-core-mu2e/Overlays/DTC_Types/DTC_LinkStatus.h"
 #include "artdaq-core-mu2e/Overlays/DTC_Types/DTC_Link_ID.h"
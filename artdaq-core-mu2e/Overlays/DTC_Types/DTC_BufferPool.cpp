@@ -0,0 +1,124 @@
+#include "artdaq-core-mu2e/Overlays/DTC_Types/DTC_BufferPool.h"
+
+#include "TRACE/tracemf.h"
+
+namespace {
+class HeapAllocator : public DTCLib::DTC_BufferAllocator
+{
+public:
+	void* Allocate(size_t bytes) override
+	{
+		return ::operator new(bytes == 0 ? 1 : bytes, std::align_val_t(kAlignment));
+	}
+	void Deallocate(void* ptr, size_t) override
+	{
+		::operator delete(ptr, std::align_val_t(kAlignment));
+	}
+};
+}  // namespace
+
+std::atomic<DTCLib::DTC_BufferAllocator*> DTCLib::DTC_BufferAllocator::default_{nullptr};
+
+DTCLib::DTC_BufferAllocator* DTCLib::DTC_BufferAllocator::Heap()
+{
+	// Never destroyed, so that buffers released during static destruction can still be freed
+	static auto heap = new HeapAllocator();
+	return heap;
+}
+
+DTCLib::DTC_Buffer::DTC_Buffer(size_t size, DTC_BufferAllocator* allocator)
+	: allocator_(allocator ? allocator : DTC_BufferAllocator::Default()), size_(size)
+{
+	data_ = static_cast<uint8_t*>(allocator_->Allocate(size_));
+}
+
+DTCLib::DTC_Buffer::~DTC_Buffer()
+{
+	allocator_->Deallocate(data_, size_);
+}
+
+DTCLib::DTC_BufferPool::DTC_BufferPool(Config const& config)
+	: config_(config) {}
+
+DTCLib::DTC_BufferPool::~DTC_BufferPool() { Trim(); }
+
+DTCLib::DTC_BufferPool& DTCLib::DTC_BufferPool::Instance()
+{
+	// Never destroyed, so that buffers released during static destruction can still be returned
+	static auto instance = new DTC_BufferPool();
+	return *instance;
+}
+
+size_t DTCLib::DTC_BufferPool::ClassIndex(size_t bytes)
+{
+	if (bytes <= ClassSize(0)) return 0;
+	size_t bits = 64 - __builtin_clzll(bytes - 1);  // Round up to a power of two
+	return bits - kMinClassBits;
+}
+
+void* DTCLib::DTC_BufferPool::Allocate(size_t bytes)
+{
+	auto index = ClassIndex(bytes);
+	if (!IsPooled(index)) return Heap()->Allocate(bytes);
+
+	auto& sizeClass = classes_[index];
+	{
+		std::lock_guard<std::mutex> lock(sizeClass.mutex);
+		++sizeClass.allocations;
+		if (!sizeClass.free.empty())
+		{
+			++sizeClass.reused;
+			auto ptr = sizeClass.free.back();
+			sizeClass.free.pop_back();
+			return ptr;
+		}
+	}
+	return Heap()->Allocate(ClassSize(index));
+}
+
+void DTCLib::DTC_BufferPool::Deallocate(void* ptr, size_t bytes)
+{
+	if (ptr == nullptr) return;
+	auto index = ClassIndex(bytes);
+	if (!IsPooled(index)) return Heap()->Deallocate(ptr, bytes);
+
+	auto& sizeClass = classes_[index];
+	{
+		std::lock_guard<std::mutex> lock(sizeClass.mutex);
+		if ((sizeClass.free.size() + 1) * ClassSize(index) <= config_.maxCachedBytesPerClass)
+		{
+			sizeClass.free.push_back(ptr);
+			return;
+		}
+	}
+	Heap()->Deallocate(ptr, ClassSize(index));
+}
+
+void DTCLib::DTC_BufferPool::Trim()
+{
+	size_t freed = 0;
+	for (size_t index = 0; index < kClassCount; ++index)
+	{
+		std::vector<void*> buffers;
+		{
+			std::lock_guard<std::mutex> lock(classes_[index].mutex);
+			buffers.swap(classes_[index].free);
+		}
+		for (auto ptr : buffers) Heap()->Deallocate(ptr, ClassSize(index));
+		freed += buffers.size() * ClassSize(index);
+	}
+	TLOG(TLVL_DEBUG + 5) << "DTC_BufferPool::Trim freed " << freed << " bytes";
+}
+
+DTCLib::DTC_BufferPool::Stats DTCLib::DTC_BufferPool::GetStats() const
+{
+	Stats output;
+	for (size_t index = 0; index < kClassCount; ++index)
+	{
+		std::lock_guard<std::mutex> lock(classes_[index].mutex);
+		output.allocations += classes_[index].allocations;
+		output.reused += classes_[index].reused;
+		output.cachedBytes += classes_[index].free.size() * ClassSize(index);
+	}
+	return output;
+}
@@ -0,0 +1,217 @@
+#ifndef artdaq_core_mu2e_Overlays_DTC_Types_DTC_BufferPool_h
+#define artdaq_core_mu2e_Overlays_DTC_Types_DTC_BufferPool_h
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace DTCLib {
+
+/// <summary>
+/// Source of raw memory for DTC_Buffer. Memory is returned uninitialized. Implementations must be thread-safe, and
+/// must outlive every buffer allocated from them.
+/// </summary>
+class DTC_BufferAllocator
+{
+public:
+	virtual ~DTC_BufferAllocator() = default;
+
+	/// <summary>
+	/// Allocate uninitialized memory, aligned to kAlignment
+	/// </summary>
+	virtual void* Allocate(size_t bytes) = 0;
+	/// <summary>
+	/// Release memory returned by Allocate with the same size
+	/// </summary>
+	virtual void Deallocate(void* ptr, size_t bytes) = 0;
+
+	static constexpr size_t kAlignment = 64;  ///< Cache line
+
+	/// <summary>
+	/// Get the allocator used when none is given: the heap, unless changed with SetDefault
+	/// </summary>
+	static DTC_BufferAllocator* Default()
+	{
+		auto allocator = default_.load(std::memory_order_acquire);
+		return allocator ? allocator : Heap();
+	}
+	/// <summary>
+	/// Set the allocator used when none is given, e.g. to &amp;DTC_BufferPool::Instance(). Buffers keep the allocator
+	/// they were allocated from, so changing it does not affect existing buffers.
+	/// </summary>
+	/// <param name="allocator">New default allocator, nullptr for the heap</param>
+	static void SetDefault(DTC_BufferAllocator* allocator) { default_.store(allocator, std::memory_order_release); }
+	/// <summary>
+	/// Get the allocator which uses operator new directly
+	/// </summary>
+	static DTC_BufferAllocator* Heap();
+
+private:
+	static std::atomic<DTC_BufferAllocator*> default_;  ///< nullptr for the heap
+};
+
+/// <summary>
+/// Owned, uninitialized byte buffer, used by DTC_Event, DTC_SubEvent and DTC_DataBlock when they own their memory.
+/// Unlike std::vector&lt;uint8_t&gt;, constructing it does not zero the storage, and the storage comes from a
+/// pluggable DTC_BufferAllocator, so that it can be recycled by a DTC_BufferPool.
+/// </summary>
+class DTC_Buffer
+{
+public:
+	/// <summary>
+	/// Allocate a buffer. Its contents are uninitialized.
+	/// </summary>
+	/// <param name="size">Size, in bytes</param>
+	/// <param name="allocator">Allocator to use, nullptr for DTC_BufferAllocator::Default()</param>
+	explicit DTC_Buffer(size_t size, DTC_BufferAllocator* allocator = nullptr);
+	~DTC_Buffer();
+
+	DTC_Buffer(DTC_Buffer const&) = delete;
+	DTC_Buffer& operator=(DTC_Buffer const&) = delete;
+
+	/// <summary>
+	/// Allocate a shared buffer, as stored by DTC_Event, DTC_SubEvent and DTC_DataBlock
+	/// </summary>
+	static std::shared_ptr<DTC_Buffer> Make(size_t size, DTC_BufferAllocator* allocator = nullptr) { return std::make_shared<DTC_Buffer>(size, allocator); }
+
+	uint8_t* data() { return data_; }
+	const uint8_t* data() const { return data_; }
+	size_t size() const { return size_; }
+	bool empty() const { return size_ == 0; }
+	uint8_t& operator[](size_t idx) { return data_[idx]; }
+	uint8_t operator[](size_t idx) const { return data_[idx]; }
+	uint8_t* begin() { return data_; }
+	uint8_t* end() { return data_ + size_; }
+	const uint8_t* begin() const { return data_; }
+	const uint8_t* end() const { return data_ + size_; }
+
+private:
+	DTC_BufferAllocator* allocator_;
+	uint8_t* data_{nullptr};
+	size_t size_;
+};
+
+/// <summary>
+/// Size-class pool of recycled buffers. Requests are rounded up to a power of two between 64 bytes and 64 MB, and
+/// each class keeps a free list, protected by its own mutex, of up to Config::maxCachedBytesPerClass of released
+/// buffers. Larger requests, and requests whose class is larger than Config::maxCachedBytesPerClass (which could
+/// never be cached), go straight to the heap at their exact size. Storage is never zeroed.
+/// </summary>
+class DTC_BufferPool : public DTC_BufferAllocator
+{
+public:
+	struct Config
+	{
+		size_t maxCachedBytesPerClass{16 * 1024 * 1024};  ///< Released memory kept per size class; the rest is freed
+	};
+
+	static constexpr size_t kMinClassBits = 6;
+	static constexpr size_t kMaxClassBits = 26;
+	static constexpr size_t kClassCount = kMaxClassBits - kMinClassBits + 1;
+
+	DTC_BufferPool()
+		: DTC_BufferPool(Config()) {}
+	explicit DTC_BufferPool(Config const& config);
+	~DTC_BufferPool() override;
+
+	DTC_BufferPool(DTC_BufferPool const&) = delete;
+	DTC_BufferPool& operator=(DTC_BufferPool const&) = delete;
+
+	/// <summary>
+	/// Get the process-wide pool. It is never destroyed, so buffers may be released at any time.
+	/// </summary>
+	static DTC_BufferPool& Instance();
+
+	void* Allocate(size_t bytes) override;
+	void Deallocate(void* ptr, size_t bytes) override;
+
+	/// <summary>
+	/// Free all cached buffers
+	/// </summary>
+	void Trim();
+
+	/// <summary>
+	/// Counters of the pool
+	/// </summary>
+	struct Stats
+	{
+		uint64_t allocations{0};  ///< Calls to Allocate
+		uint64_t reused{0};       ///< Allocations served from a free list
+		size_t cachedBytes{0};    ///< Memory currently held in free lists
+	};
+	Stats GetStats() const;
+
+private:
+	struct SizeClass
+	{
+		mutable std::mutex mutex;
+		std::vector<void*> free;
+		uint64_t allocations{0};
+		uint64_t reused{0};
+	};
+
+	static size_t ClassIndex(size_t bytes);
+	static size_t ClassSize(size_t index) { return size_t(1) << (index + kMinClassBits); }
+	bool IsPooled(size_t index) const { return index < kClassCount && ClassSize(index) <= config_.maxCachedBytesPerClass; }
+
+	Config config_;
+	std::array<SizeClass, kClassCount> classes_;
+};
+
+/// <summary>
+/// STL allocator drawing from a DTC_BufferAllocator, which default-initializes instead of value-initializing, so that
+/// e.g. std::vector&lt;uint8_t, DTC_PoolAllocator&lt;uint8_t&gt;&gt;::resize does not zero the new elements.
+/// </summary>
+template<typename T>
+class DTC_PoolAllocator
+{
+public:
+	using value_type = T;
+
+	DTC_PoolAllocator() noexcept
+		: allocator_(DTC_BufferAllocator::Default()) {}
+	explicit DTC_PoolAllocator(DTC_BufferAllocator* allocator) noexcept
+		: allocator_(allocator ? allocator : DTC_BufferAllocator::Default()) {}
+	template<typename U>
+	DTC_PoolAllocator(DTC_PoolAllocator<U> const& other) noexcept
+		: allocator_(other.allocator()) {}
+
+	T* allocate(size_t n)
+	{
+		static_assert(alignof(T) <= DTC_BufferAllocator::kAlignment, "DTC_PoolAllocator does not support over-aligned types");
+		return static_cast<T*>(allocator_->Allocate(n * sizeof(T)));
+	}
+	void deallocate(T* ptr, size_t n) { allocator_->Deallocate(ptr, n * sizeof(T)); }
+
+	template<typename U>
+	void construct(U* ptr) noexcept(std::is_nothrow_default_constructible<U>::value)
+	{
+		::new (static_cast<void*>(ptr)) U;
+	}
+	template<typename U, typename... Args>
+	void construct(U* ptr, Args&&... args)
+	{
+		::new (static_cast<void*>(ptr)) U(std::forward<Args>(args)...);
+	}
+
+	DTC_BufferAllocator* allocator() const { return allocator_; }
+
+	template<typename U>
+	bool operator==(DTC_PoolAllocator<U> const& other) const { return allocator_ == other.allocator(); }
+	template<typename U>
+	bool operator!=(DTC_PoolAllocator<U> const& other) const { return allocator_ != other.allocator(); }
+
+private:
+	DTC_BufferAllocator* allocator_;
+};
+
+}  // namespace DTCLib
+
+#endif  // artdaq_core_mu2e_Overlays_DTC_Types_DTC_BufferPool_h
@@ -0,0 +1,138 @@
+#ifndef artdaq_core_mu2e_Overlays_DTC_Types_DTC_EWT_h
+#define artdaq_core_mu2e_Overlays_DTC_Types_DTC_EWT_h
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>  // std::hash
+
+namespace DTCLib {
+
+/// <summary>
+/// Lightweight 48-bit Event Window Tag. Trivially copyable and usable in constant expressions, for use in sorting and
+/// matching. The value is held in the low 48 bits of a uint64_t, which is also the representation of mu2e::EWT.
+/// </summary>
+class DTC_EWT
+{
+public:
+	static constexpr int kBits = 48;                          ///< Number of bits in an Event Window Tag
+	static constexpr uint64_t kMask = (uint64_t(1) << kBits) - 1;  ///< Mask of the valid bits
+
+	/// <summary>
+	/// Construct a DTC_EWT with value 0
+	/// </summary>
+	constexpr DTC_EWT() = default;
+	/// <summary>
+	/// Construct a DTC_EWT from a 64-bit value. Top 16 bits will be discarded
+	/// </summary>
+	/// <param name="value">Event Window Tag</param>
+	constexpr explicit DTC_EWT(uint64_t value)
+		: value_(value & kMask) {}
+	/// <summary>
+	/// Construct a DTC_EWT from its low and high words
+	/// </summary>
+	/// <param name="low">Lower 32 bits of the Event Window Tag</param>
+	/// <param name="high">Upper 16 bits of the Event Window Tag</param>
+	constexpr DTC_EWT(uint32_t low, uint16_t high)
+		: value_(low | (static_cast<uint64_t>(high) << 32)) {}
+
+	/// <summary>
+	/// Read a DTC_EWT from 6 little-endian bytes. No alignment requirement, and only 6 bytes are read.
+	/// </summary>
+	/// <param name="bytes">Pointer to byte 0 of the Event Window Tag</param>
+	/// <returns>DTC_EWT</returns>
+	static constexpr DTC_EWT LoadLE(const uint8_t* bytes)
+	{
+		return DTC_EWT(static_cast<uint64_t>(bytes[0]) | (static_cast<uint64_t>(bytes[1]) << 8) | (static_cast<uint64_t>(bytes[2]) << 16) |
+					   (static_cast<uint64_t>(bytes[3]) << 24) | (static_cast<uint64_t>(bytes[4]) << 32) | (static_cast<uint64_t>(bytes[5]) << 40));
+	}
+	/// <summary>
+	/// Write the DTC_EWT as 6 little-endian bytes
+	/// </summary>
+	/// <param name="bytes">Pointer to byte 0 of the destination</param>
+	constexpr void StoreLE(uint8_t* bytes) const
+	{
+		for (int ii = 0; ii < 6; ++ii)
+		{
+			bytes[ii] = static_cast<uint8_t>(value_ >> (8 * ii));
+		}
+	}
+
+	/// <summary>
+	/// Convert from mu2e::EWT (uint64_t). Top 16 bits will be discarded
+	/// </summary>
+	static constexpr DTC_EWT FromEWT(uint64_t ewt) { return DTC_EWT(ewt); }
+	/// <summary>
+	/// Convert to mu2e::EWT (uint64_t)
+	/// </summary>
+	constexpr uint64_t ToEWT() const { return value_; }
+	/// <summary>
+	/// Get the Event Window Tag as a 64-bit unsigned integer
+	/// </summary>
+	constexpr uint64_t value() const { return value_; }
+	/// <summary>
+	/// Get the lower 32 bits of the Event Window Tag
+	/// </summary>
+	constexpr uint32_t low() const { return static_cast<uint32_t>(value_); }
+	/// <summary>
+	/// Get the upper 16 bits of the Event Window Tag
+	/// </summary>
+	constexpr uint16_t high() const { return static_cast<uint16_t>(value_ >> 32); }
+
+	/// <summary>
+	/// Signed number of Event Windows from this tag to the other, taking the shorter way around the 48-bit wrap.
+	/// Positive if other is later than this tag.
+	/// </summary>
+	/// <param name="other">Other Event Window Tag</param>
+	/// <returns>other - this, in the range [-2^47, 2^47)</returns>
+	constexpr int64_t DistanceTo(DTC_EWT other) const
+	{
+		uint64_t diff = (other.value_ - value_) & kMask;
+		return diff & (uint64_t(1) << (kBits - 1)) ? static_cast<int64_t>(diff) - static_cast<int64_t>(uint64_t(1) << kBits) : static_cast<int64_t>(diff);
+	}
+	/// <summary>
+	/// Wrap-aware ordering: whether this tag comes before the other, within half the 48-bit range
+	/// </summary>
+	constexpr bool IsBefore(DTC_EWT other) const { return DistanceTo(other) > 0; }
+
+	constexpr bool operator==(DTC_EWT r) const { return value_ == r.value_; }
+	constexpr bool operator!=(DTC_EWT r) const { return value_ != r.value_; }
+	constexpr bool operator<(DTC_EWT r) const { return value_ < r.value_; }
+	constexpr bool operator<=(DTC_EWT r) const { return value_ <= r.value_; }
+	constexpr bool operator>(DTC_EWT r) const { return value_ > r.value_; }
+	constexpr bool operator>=(DTC_EWT r) const { return value_ >= r.value_; }
+
+	/// <summary>
+	/// Add a (possibly negative) number of Event Windows, wrapping at 48 bits
+	/// </summary>
+	constexpr DTC_EWT operator+(int64_t r) const { return DTC_EWT(value_ + static_cast<uint64_t>(r)); }
+	/// <summary>
+	/// Subtract a (possibly negative) number of Event Windows, wrapping at 48 bits
+	/// </summary>
+	constexpr DTC_EWT operator-(int64_t r) const { return DTC_EWT(value_ - static_cast<uint64_t>(r)); }
+	constexpr DTC_EWT& operator+=(int64_t r) { return *this = *this + r; }
+	constexpr DTC_EWT& operator-=(int64_t r) { return *this = *this - r; }
+	constexpr DTC_EWT& operator++() { return *this += 1; }
+
+private:
+	uint64_t value_{0};
+};
+
+}  // namespace DTCLib
+
+namespace std {
+/// <summary>
+/// Hash of a DTC_EWT, for use in unordered containers
+/// </summary>
+template<>
+struct hash<DTCLib::DTC_EWT>
+{
+	size_t operator()(DTCLib::DTC_EWT ewt) const noexcept
+	{
+		// Event Window Tags are mostly consecutive; mix the bits so that they spread over the buckets
+		uint64_t x = ewt.value() * 0x9E3779B97F4A7C15ULL;
+		return static_cast<size_t>(x ^ (x >> 32));
+	}
+};
+}  // namespace std
+
+#endif  // artdaq_core_mu2e_Overlays_DTC_Types_DTC_EWT_h
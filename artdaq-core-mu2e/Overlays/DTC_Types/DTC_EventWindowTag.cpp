@@ -1,7 +1,6 @@
 #include "artdaq-core-mu2e/Overlays/DTC_Types/DTC_EventWindowTag.h"
 
 #include <iomanip>
-#include <sstream>
 
 DTCLib::DTC_EventWindowTag::DTC_EventWindowTag()
 	: event_tag_(0) {}
@@ -16,8 +15,7 @@ DTCLib::DTC_EventWindowTag::DTC_EventWindowTag(const uint32_t event_tag_low, con
 
 DTCLib::DTC_EventWindowTag::DTC_EventWindowTag(const uint8_t* timeArr, int offset)
 {
-	auto arr = reinterpret_cast<const uint64_t*>(timeArr + offset);
-	event_tag_ = *arr;
+	event_tag_ = DTC_EWT::LoadLE(timeArr + offset).value();
 }
 
 DTCLib::DTC_EventWindowTag::DTC_EventWindowTag(const std::bitset<48> event_tag)
@@ -32,44 +30,49 @@ void DTCLib::DTC_EventWindowTag::SetEventWindowTag(const uint32_t event_tag_low,
 
 void DTCLib::DTC_EventWindowTag::GetEventWindowTag(const uint8_t* timeArr, int offset) const
 {
-	for (auto i = 0; i < 6; i++)
-	{
-		const_cast<uint8_t*>(timeArr)[i + offset] = static_cast<uint8_t>(event_tag_ >> i * 8);
-	}
+	GetEWT().StoreLE(const_cast<uint8_t*>(timeArr) + offset);
 }
 
 std::string DTCLib::DTC_EventWindowTag::toJSON(bool arrayMode) const
 {
-	std::stringstream ss;
+	std::string output;
+	DTC_JSONWriter writer(output);
+	AppendJSON(writer, arrayMode);
+	return output;
+}
+
+void DTCLib::DTC_EventWindowTag::AppendJSON(DTC_JSONWriter& writer, bool arrayMode) const
+{
 	if (arrayMode)
 	{
-		uint8_t ts[6];
+		uint8_t ts[6]{0, 0, 0, 0, 0, 0};
 		GetEventWindowTag(ts, 0);
-		ss << "\t\"timestamp\": [\n" << static_cast<int>(ts[0]) << ",\n";
-		ss << static_cast<int>(ts[1]) << ",\n";
-		ss << static_cast<int>(ts[2]) << ",\n";
-		ss << static_cast<int>(ts[3]) << ",\n";
-		ss << static_cast<int>(ts[4]) << ",\n";
-		ss << static_cast<int>(ts[5]) << "\n]";
+		writer.Key("timestamp").Raw("[\n");
+		for (int ii = 0; ii < 6; ++ii)
+		{
+			writer.Dec(ts[ii]).Raw(ii < 5 ? ",\n" : "\n]");
+		}
 	}
 	else
 	{
-		ss << "\t\"timestamp\": " << event_tag_;
+		writer.Key("timestamp").Dec(event_tag_);
 	}
-	return ss.str();
 }
 
 std::string DTCLib::DTC_EventWindowTag::toPacketFormat() const
 {
-	uint8_t ts[6]{0,0,0,0,0,0};
+	std::string output;
+	DTC_JSONWriter writer(output);
+	AppendPacketFormat(writer);
+	return output;
+}
+
+void DTCLib::DTC_EventWindowTag::AppendPacketFormat(DTC_JSONWriter& writer) const
+{
+	uint8_t ts[6]{0, 0, 0, 0, 0, 0};
 	GetEventWindowTag(ts, 0);
-	std::stringstream ss;
-	ss << std::setfill('0') << std::hex;
-	ss << "0x" << std::setw(6) << static_cast<int>(ts[1]) << "\t"
-	   << "0x" << std::setw(6) << static_cast<int>(ts[0]) << "\n";
-	ss << "0x" << std::setw(6) << static_cast<int>(ts[3]) << "\t"
-	   << "0x" << std::setw(6) << static_cast<int>(ts[2]) << "\n";
-	ss << "0x" << std::setw(6) << static_cast<int>(ts[5]) << "\t"
-	   << "0x" << std::setw(6) << static_cast<int>(ts[4]) << "\n";
-	return ss.str();
+	for (int ii = 0; ii < 6; ii += 2)
+	{
+		writer.PrefixedHex(ts[ii + 1], 6).Raw("\t").PrefixedHex(ts[ii], 6).Raw("\n");
+	}
 }
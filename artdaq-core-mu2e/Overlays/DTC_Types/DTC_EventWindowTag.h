@@ -1,6 +1,9 @@
 #ifndef artdaq_core_mu2e_Overlays_DTC_Types_DTC_EventWindowTag_h
 #define artdaq_core_mu2e_Overlays_DTC_Types_DTC_EventWindowTag_h
 
+#include "artdaq-core-mu2e/Overlays/DTC_Types/DTC_EWT.h"
+#include "artdaq-core-mu2e/Overlays/DTC_Types/DTC_JSONWriter.h"
+
 #include <bitset>
 #include <cstdint>
 #include <string>
@@ -42,6 +45,12 @@ public:
 	/// <param name="event_tag">std::bitset containing event_tag</param>
 	explicit DTC_EventWindowTag(const std::bitset<48> event_tag);
 	/// <summary>
+	/// Construct a DTC_EventWindowTag from a DTC_EWT
+	/// </summary>
+	/// <param name="event_tag">DTC_EWT containing event_tag</param>
+	explicit DTC_EventWindowTag(const DTC_EWT event_tag)
+		: event_tag_(event_tag.value()) {}
+	/// <summary>
 	/// Default copy constructor
 	/// </summary>
 	/// <param name="r">DTC_EventWindowTag to copy</param>
@@ -137,6 +146,12 @@ public:
 		return 0;
 	}
 
+	/// <summary>
+	/// Returns the Event Window Tag as a DTC_EWT, for cheap comparison and hashing
+	/// </summary>
+	/// <returns>event_tag as a DTC_EWT</returns>
+	DTC_EWT GetEWT() const { return DTC_EWT(event_tag_); }
+
 	/// <summary>
 	/// Copies the Event Window Tag into the given byte array, starting at some offset.
 	/// Size of input array MUST be larger than offset + 6
@@ -151,6 +166,12 @@ public:
 	/// <param name="arrayMode">(Default: false) If true, will create a JSON array of the 6 bytes. Otherwise, represents
 	/// event_tag as a single number</param> <returns>JSON-formatted string containing event_tag</returns>
 	std::string toJSON(bool arrayMode = false) const;
+	/// <summary>
+	/// Append the JSON representation of the Event Window Tag (see toJSON()) as a member of the writer's current object
+	/// </summary>
+	/// <param name="writer">DTC_JSONWriter to append to</param>
+	/// <param name="arrayMode">(Default: false) If true, will create a JSON array of the 6 bytes</param>
+	void AppendJSON(DTC_JSONWriter& writer, bool arrayMode = false) const;
 
 	/// <summary>
 	/// Convert the 48-bit event_tag to the format used in the Packet format definitions.
@@ -160,6 +181,11 @@ public:
 	/// </summary>
 	/// <returns>String representing event_tag in "packet format"</returns>
 	std::string toPacketFormat() const;
+	/// <summary>
+	/// Append the "packet format" representation of the Event Window Tag (see toPacketFormat())
+	/// </summary>
+	/// <param name="writer">DTC_JSONWriter to append to</param>
+	void AppendPacketFormat(DTC_JSONWriter& writer) const;
 };
 
 }  // namespace DTCLib
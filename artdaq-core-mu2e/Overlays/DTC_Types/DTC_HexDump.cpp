@@ -0,0 +1,207 @@
+#include "artdaq-core-mu2e/Overlays/DTC_Types/DTC_HexDump.h"
+
+#include "artdaq-core-mu2e/Overlays/DTC_Packets/DTC_PacketType.h"
+
+#include <array>
+#include <cerrno>
+#include <charconv>
+#include <cstring>
+#include <unistd.h>
+
+namespace {
+// Two hex digits for every byte value, so that a byte is formatted with one lookup
+constexpr std::array<std::array<char, 2>, 256> makeHexTable()
+{
+	constexpr char digits[] = "0123456789abcdef";
+	std::array<std::array<char, 2>, 256> table{};
+	for (size_t ii = 0; ii < table.size(); ++ii)
+	{
+		table[ii][0] = digits[ii >> 4];
+		table[ii][1] = digits[ii & 0xF];
+	}
+	return table;
+}
+constexpr auto hexTable = makeHexTable();
+
+constexpr std::array<const char*, 16> makePacketTypeNames()
+{
+	std::array<const char*, 16> names{};
+	for (auto& name : names) name = "Unknown";
+	names[DTCLib::DTC_PacketType_DCSRequest] = "DCSRequest";
+	names[DTCLib::DTC_PacketType_Heartbeat] = "Heartbeat";
+	names[DTCLib::DTC_PacketType_DataRequest] = "DataRequest";
+	names[DTCLib::DTC_PacketType_DCSReply] = "DCSReply";
+	names[DTCLib::DTC_PacketType_DataHeader] = "DataHeader";
+	// Types with no DTC_PacketType value, from the packet type list in DTC_DCSReplyPacket.cpp
+	names[3] = "PrefetchRequest";
+	names[6] = "DataPayload";
+	names[7] = "DCSBlockWritePayload";
+	names[8] = "DCSBlockReadPayload";
+	return names;
+}
+constexpr auto packetTypeNames = makePacketTypeNames();
+
+char* putByte(char* out, uint8_t byte)
+{
+	out[0] = hexTable[byte][0];
+	out[1] = hexTable[byte][1];
+	return out + 2;
+}
+
+char* putString(char* out, const char* str)
+{
+	auto len = strlen(str);
+	memcpy(out, str, len);
+	return out + len;
+}
+
+char* putDecimal(char* out, size_t value)
+{
+	// Callers only pass values which fit in the line budget (at most 20 digits)
+	return std::to_chars(out, out + 20, value).ptr;
+}
+}  // namespace
+
+DTCLib::DTC_HexDump::DTC_HexDump(const void* ptr, size_t sz, Options const& options)
+	: ptr_(static_cast<const uint8_t*>(ptr)), sz_(sz), options_(options), lineCount_((sz + 15) / 16)
+{
+	elide_ = options_.quietCount > 0 && lineCount_ > options_.quietCount * 2;
+}
+
+size_t DTCLib::DTC_HexDump::FormatNext(char* out, size_t capacity)
+{
+	auto start = out;
+	for (size_t items = capacity / kMaxLineLength; items > 0 && !Done(); --items)
+	{
+		out += WriteItem(out);
+	}
+	return out - start;
+}
+
+size_t DTCLib::DTC_HexDump::WriteItem(char* out)
+{
+	if (elide_ && !elided_ && line_ == options_.quietCount)
+	{
+		auto len = FormatElision(out);
+		elided_ = true;
+		line_ = lineCount_ - options_.quietCount;
+		return len;
+	}
+	auto len = FormatLine(out);
+	++line_;
+	return len;
+}
+
+// Same layout as the original Utilities::PrintBuffer: "0x" + line number (5 hex digits) + "0: " + eight 16-bit words
+size_t DTCLib::DTC_HexDump::FormatLine(char* out)
+{
+	auto start = out;
+	*out++ = '0';
+	*out++ = 'x';
+	auto line = line_ & 0xFFFFF;
+	*out++ = hexTable[(line >> 16) & 0xF][1];
+	out = putByte(out, static_cast<uint8_t>(line >> 8));
+	out = putByte(out, static_cast<uint8_t>(line));
+	*out++ = '0';
+	*out++ = ':';
+	*out++ = ' ';
+
+	auto bytes = ptr_ + line_ * 16;
+	auto nBytes = sz_ - line_ * 16 < 16 ? sz_ - line_ * 16 : 16;
+	for (size_t ii = 0; ii + 1 < nBytes; ii += 2)
+	{
+		out = putByte(out, bytes[ii + 1]);
+		out = putByte(out, bytes[ii]);
+		*out++ = ' ';
+	}
+	if (nBytes % 2)
+	{
+		out = putByte(out, bytes[nBytes - 1]);
+		*out++ = ' ';
+	}
+
+	if (options_.annotatePackets) out += Annotate(out);
+	*out++ = '\n';
+	return out - start;
+}
+
+size_t DTCLib::DTC_HexDump::FormatElision(char* out) const
+{
+	auto start = out;
+	auto skipped = lineCount_ - 2 * options_.quietCount;
+	out = putString(out, "... ");
+	out = putDecimal(out, skipped);
+	out = putString(out, " lines (");
+	out = putDecimal(out, skipped * 16);
+	out = putString(out, " bytes) not shown ...\n");
+	return out - start;
+}
+
+// Walk the DMA packet headers up to the current line, using each header's byte count to find the next one. Lines
+// skipped by the elision are walked header-to-header, not byte-by-byte.
+size_t DTCLib::DTC_HexDump::Annotate(char* out)
+{
+	while (nextPacket_ <= line_)
+	{
+		auto header = ptr_ + nextPacket_ * 16;
+		if (sz_ - nextPacket_ * 16 < 4) return 0;
+
+		size_t byteCount = header[0] + (header[1] << 8);
+		size_t packets = byteCount == 0 ? 1 : (byteCount + 15) / 16;
+		if (nextPacket_ < line_)
+		{
+			nextPacket_ += packets;
+			continue;
+		}
+		nextPacket_ += packets;
+
+		auto start = out;
+		out = putString(out, "| ");
+		out = putString(out, packetTypeNames[(header[2] >> 4) & 0xF]);
+		out = putString(out, " link ");
+		out = putDecimal(out, header[3] & 0x7);
+		out = putString(out, ", ");
+		out = putDecimal(out, byteCount);
+		out = putString(out, " bytes");
+		if ((header[3] & 0x80) == 0) out = putString(out, ", not valid");
+		return out - start;
+	}
+	return 0;
+}
+
+size_t DTCLib::DTC_HexDump::Format(char* out, size_t capacity, const void* ptr, size_t sz, Options const& options)
+{
+	DTC_HexDump dump(ptr, sz, options);
+	return dump.FormatNext(out, capacity);
+}
+
+std::string DTCLib::DTC_HexDump::ToString(const void* ptr, size_t sz, Options const& options)
+{
+	DTC_HexDump dump(ptr, sz, options);
+	auto lines = dump.elide_ ? 2 * options.quietCount + 1 : dump.lineCount_;
+	std::string output(lines * kMaxLineLength, '\0');
+	output.resize(dump.FormatNext(&output[0], output.size()));
+	return output;
+}
+
+bool DTCLib::DTC_HexDump::Write(int fd, const void* ptr, size_t sz, Options const& options)
+{
+	DTC_HexDump dump(ptr, sz, options);
+	char buffer[64 * kMaxLineLength];
+	while (!dump.Done())
+	{
+		auto len = dump.FormatNext(buffer, sizeof(buffer));
+		size_t written = 0;
+		while (written < len)
+		{
+			auto res = ::write(fd, buffer + written, len - written);
+			if (res < 0)
+			{
+				if (errno == EINTR) continue;
+				return false;
+			}
+			written += res;
+		}
+	}
+	return true;
+}
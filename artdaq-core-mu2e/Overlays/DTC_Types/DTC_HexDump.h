@@ -0,0 +1,91 @@
+#ifndef artdaq_core_mu2e_Overlays_DTC_Types_DTC_HexDump_h
+#define artdaq_core_mu2e_Overlays_DTC_Types_DTC_HexDump_h
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace DTCLib {
+
+/// <summary>
+/// Options for DTC_HexDump
+/// </summary>
+struct DTC_HexDumpOptions
+{
+	size_t quietCount{0};         ///< Number of lines to print at the begin/end. 0 prints the entire buffer
+	bool annotatePackets{false};  ///< Buffer starts at a DMA packet; annotate each packet header
+};
+
+/// <summary>
+/// Table-driven hex formatter for DMA buffers, in the format of Utilities::PrintBuffer: one line per 16-byte packet,
+/// with the byte offset followed by eight little-endian 16-bit words. Lines are produced in one pass into
+/// caller-supplied memory, with no per-line allocation. Optionally, only the first and last quietCount lines are
+/// printed, and each DMA packet header is annotated with its DTC_PacketType, link and size.
+/// </summary>
+class DTC_HexDump
+{
+public:
+	using Options = DTC_HexDumpOptions;
+
+	static constexpr size_t kMaxLineLength = 128;  ///< Upper bound on the length of one line, including the newline
+
+	/// <summary>
+	/// Construct a DTC_HexDump for a buffer. The buffer is not copied and must outlive the DTC_HexDump.
+	/// </summary>
+	/// <param name="ptr">Pointer to the buffer</param>
+	/// <param name="sz">Size of the buffer, in bytes</param>
+	/// <param name="options">Elision and annotation options</param>
+	DTC_HexDump(const void* ptr, size_t sz, Options const& options);
+	DTC_HexDump(const void* ptr, size_t sz)
+		: DTC_HexDump(ptr, sz, Options()) {}
+
+	/// <summary>
+	/// Format the next capacity / kMaxLineLength lines. Only whole lines are written, each terminated by a newline;
+	/// the output is not null-terminated.
+	/// </summary>
+	/// <param name="out">Output buffer</param>
+	/// <param name="capacity">Size of the output buffer. Must be at least kMaxLineLength to make progress</param>
+	/// <returns>Number of characters written, 0 once all lines have been written</returns>
+	size_t FormatNext(char* out, size_t capacity);
+
+	/// <summary>
+	/// Whether all lines have been written
+	/// </summary>
+	bool Done() const { return line_ >= lineCount_; }
+
+	/// <summary>
+	/// Format a whole buffer into memory. Output is truncated at a line boundary if it does not fit.
+	/// </summary>
+	/// <returns>Number of characters written</returns>
+	static size_t Format(char* out, size_t capacity, const void* ptr, size_t sz, Options const& options = Options());
+
+	/// <summary>
+	/// Format a whole buffer into a std::string, allocating it once
+	/// </summary>
+	static std::string ToString(const void* ptr, size_t sz, Options const& options = Options());
+
+	/// <summary>
+	/// Write a whole buffer to a file descriptor, formatting it in fixed-size chunks on the stack
+	/// </summary>
+	/// <returns>False if a write failed</returns>
+	static bool Write(int fd, const void* ptr, size_t sz, Options const& options = Options());
+
+private:
+	size_t WriteItem(char* out);
+	size_t FormatLine(char* out);
+	size_t FormatElision(char* out) const;
+	size_t Annotate(char* out);
+
+	const uint8_t* ptr_;
+	size_t sz_;
+	Options options_;
+	size_t lineCount_;       ///< Number of 16-byte lines in the buffer
+	size_t line_{0};         ///< Next line to write
+	bool elide_{false};      ///< Whether lines [quietCount, lineCount - quietCount) are replaced by one elision line
+	bool elided_{false};     ///< Whether the elision line has been written
+	size_t nextPacket_{0};   ///< Line of the next DMA packet header, when annotating
+};
+
+}  // namespace DTCLib
+
+#endif  // artdaq_core_mu2e_Overlays_DTC_Types_DTC_HexDump_h
@@ -0,0 +1,253 @@
+#include "artdaq-core-mu2e/Overlays/DTC_Types/DTC_Instrumentation.h"
+
+#include "artdaq-core-mu2e/Overlays/DTC_Types/DTC_JSONWriter.h"
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+namespace {
+// Counters of one thread. Only the owning thread writes them, so increments are a relaxed load and store rather than
+// an atomic read-modify-write; the atomics only make the concurrent reads in Snapshot() well-defined.
+struct ThreadCounters
+{
+	struct Stage
+	{
+		std::atomic<uint64_t> calls{0};
+		std::atomic<uint64_t> bytes{0};
+		std::atomic<uint64_t> items{0};
+		std::atomic<uint64_t> ticks{0};
+		std::array<std::atomic<uint64_t>, DTCLib::DTC_StageStats::kHistogramBuckets> latency{};
+	};
+	alignas(64) std::array<Stage, DTCLib::DTC_InstrumentationStageCount> stages;
+
+	void AddTo(std::array<DTCLib::DTC_StageStats, DTCLib::DTC_InstrumentationStageCount>& output) const
+	{
+		for (size_t ii = 0; ii < stages.size(); ++ii)
+		{
+			output[ii].calls += stages[ii].calls.load(std::memory_order_relaxed);
+			output[ii].bytes += stages[ii].bytes.load(std::memory_order_relaxed);
+			output[ii].items += stages[ii].items.load(std::memory_order_relaxed);
+			output[ii].ticks += stages[ii].ticks.load(std::memory_order_relaxed);
+			for (size_t bb = 0; bb < output[ii].latency.size(); ++bb)
+			{
+				output[ii].latency[bb] += stages[ii].latency[bb].load(std::memory_order_relaxed);
+			}
+		}
+	}
+};
+
+inline void bump(std::atomic<uint64_t>& counter, uint64_t value)
+{
+	counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+}
+
+// Counters of all live threads, plus the totals of threads which have exited
+struct Registry
+{
+	std::mutex mutex;
+	std::vector<ThreadCounters*> live;
+	std::array<DTCLib::DTC_StageStats, DTCLib::DTC_InstrumentationStageCount> retired{};
+	uint64_t startTicks{DTCLib::DTC_Instrumentation::Now()};
+	std::chrono::steady_clock::time_point startTime{std::chrono::steady_clock::now()};
+};
+
+// Never destroyed, since threads may exit after static destruction has started
+Registry& registry()
+{
+	static Registry* instance = new Registry();
+	return *instance;
+}
+
+// Initialized at load time, so that the snapshot wall time and tick rate calibration start there
+[[maybe_unused]] Registry& loadTimeRegistry = registry();
+
+struct ThreadHandle
+{
+	ThreadHandle()
+		: counters(new ThreadCounters())
+	{
+		std::lock_guard<std::mutex> lk(registry().mutex);
+		registry().live.push_back(counters);
+	}
+	~ThreadHandle()
+	{
+		auto& reg = registry();
+		std::lock_guard<std::mutex> lk(reg.mutex);
+		counters->AddTo(reg.retired);
+		for (auto it = reg.live.begin(); it != reg.live.end(); ++it)
+		{
+			if (*it == counters)
+			{
+				reg.live.erase(it);
+				break;
+			}
+		}
+		delete counters;
+	}
+	ThreadHandle(ThreadHandle const&) = delete;
+	ThreadHandle& operator=(ThreadHandle const&) = delete;
+
+	ThreadCounters* counters;
+};
+}  // namespace
+
+const char* DTCLib::DTC_InstrumentationStageName(DTC_InstrumentationStage stage)
+{
+	switch (stage)
+	{
+		case DTC_InstrumentationStage::SetupEvent:
+			return "SetupEvent";
+		case DTC_InstrumentationStage::SetupSubEvent:
+			return "SetupSubEvent";
+		case DTC_InstrumentationStage::HeaderDecode:
+			return "HeaderDecode";
+		case DTC_InstrumentationStage::TrackerDecode:
+			return "TrackerDecode";
+		case DTC_InstrumentationStage::CalorimeterDecode:
+			return "CalorimeterDecode";
+		case DTC_InstrumentationStage::CRVDecode:
+			return "CRVDecode";
+		case DTC_InstrumentationStage::Count:
+			break;
+	}
+	return "Unknown";
+}
+
+uint64_t DTCLib::DTC_StageStats::LatencyQuantile(double fraction) const
+{
+	if (calls == 0) return 0;
+	auto target = static_cast<uint64_t>(fraction * calls);
+	if (target >= calls) target = calls - 1;
+
+	uint64_t seen = 0;
+	for (size_t ii = 0; ii < latency.size(); ++ii)
+	{
+		seen += latency[ii];
+		if (seen > target) return 1ULL << ii;
+	}
+	return 1ULL << (latency.size() - 1);
+}
+
+DTCLib::DTC_StageStats& DTCLib::DTC_StageStats::operator+=(DTC_StageStats const& other)
+{
+	calls += other.calls;
+	bytes += other.bytes;
+	items += other.items;
+	ticks += other.ticks;
+	for (size_t ii = 0; ii < latency.size(); ++ii) latency[ii] += other.latency[ii];
+	return *this;
+}
+
+DTCLib::DTC_StageStats& DTCLib::DTC_StageStats::operator-=(DTC_StageStats const& other)
+{
+	calls -= other.calls;
+	bytes -= other.bytes;
+	items -= other.items;
+	ticks -= other.ticks;
+	for (size_t ii = 0; ii < latency.size(); ++ii) latency[ii] -= other.latency[ii];
+	return *this;
+}
+
+double DTCLib::DTC_InstrumentationSnapshot::BusySeconds(DTC_InstrumentationStage stage) const
+{
+	if (ticksPerSecond <= 0) return 0;
+	return (*this)[stage].ticks / ticksPerSecond;
+}
+
+double DTCLib::DTC_InstrumentationSnapshot::BytesPerSecond(DTC_InstrumentationStage stage) const
+{
+	auto busy = BusySeconds(stage);
+	return busy > 0 ? (*this)[stage].bytes / busy : 0;
+}
+
+double DTCLib::DTC_InstrumentationSnapshot::CallsPerSecond(DTC_InstrumentationStage stage) const
+{
+	return wallNanoseconds > 0 ? (*this)[stage].calls * 1e9 / wallNanoseconds : 0;
+}
+
+double DTCLib::DTC_InstrumentationSnapshot::LatencyQuantileSeconds(DTC_InstrumentationStage stage, double fraction) const
+{
+	if (ticksPerSecond <= 0) return 0;
+	return (*this)[stage].LatencyQuantile(fraction) / ticksPerSecond;
+}
+
+DTCLib::DTC_InstrumentationSnapshot DTCLib::DTC_InstrumentationSnapshot::operator-(DTC_InstrumentationSnapshot const& earlier) const
+{
+	DTC_InstrumentationSnapshot output(*this);
+	for (size_t ii = 0; ii < stages.size(); ++ii) output.stages[ii] -= earlier.stages[ii];
+	output.wallNanoseconds = wallNanoseconds > earlier.wallNanoseconds ? wallNanoseconds - earlier.wallNanoseconds : 0;
+	return output;
+}
+
+std::string DTCLib::DTC_InstrumentationSnapshot::toJSON() const
+{
+	std::string output;
+	DTC_JSONWriter writer(output);
+	writer.BeginObject("DTC_Instrumentation");
+	writer.Field("wall_ns", wallNanoseconds);
+	for (size_t ii = 0; ii < stages.size(); ++ii)
+	{
+		auto stage = static_cast<DTC_InstrumentationStage>(ii);
+		auto const& stats = stages[ii];
+		writer.Key(DTC_InstrumentationStageName(stage)).Raw("{ \"calls\": ").Dec(stats.calls);
+		writer.Raw(", \"bytes\": ").Dec(stats.bytes).Raw(", \"items\": ").Dec(stats.items);
+		writer.Raw(", \"busy_ns\": ").Dec(static_cast<uint64_t>(BusySeconds(stage) * 1e9));
+		writer.Raw(", \"bytes_per_s\": ").Dec(static_cast<uint64_t>(BytesPerSecond(stage)));
+		writer.Raw(", \"p50_ns\": ").Dec(static_cast<uint64_t>(LatencyQuantileSeconds(stage, 0.5) * 1e9));
+		writer.Raw(", \"p99_ns\": ").Dec(static_cast<uint64_t>(LatencyQuantileSeconds(stage, 0.99) * 1e9)).Raw(" }");
+	}
+	writer.EndObject();
+	return output;
+}
+
+bool DTCLib::DTC_Instrumentation::Enabled()
+{
+#ifdef DTC_INSTRUMENTATION
+	return true;
+#else
+	return false;
+#endif
+}
+
+uint64_t DTCLib::DTC_Instrumentation::Now()
+{
+#if defined(__x86_64__) || defined(__i386__)
+	return __rdtsc();
+#else
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+void DTCLib::DTC_Instrumentation::Record(DTC_InstrumentationStage stage, uint64_t ticks, uint64_t bytes, uint64_t items)
+{
+	thread_local ThreadHandle handle;
+	auto& counters = handle.counters->stages[static_cast<size_t>(stage)];
+	bump(counters.calls, 1);
+	bump(counters.bytes, bytes);
+	bump(counters.items, items);
+	bump(counters.ticks, ticks);
+	bump(counters.latency[DTC_StageStats::Bucket(ticks)], 1);
+}
+
+DTCLib::DTC_InstrumentationSnapshot DTCLib::DTC_Instrumentation::Snapshot()
+{
+	DTC_InstrumentationSnapshot output;
+	auto& reg = registry();
+	{
+		std::lock_guard<std::mutex> lk(reg.mutex);
+		output.stages = reg.retired;
+		for (auto counters : reg.live) counters->AddTo(output.stages);
+	}
+
+	auto ticks = Now() - reg.startTicks;
+	auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - reg.startTime).count();
+	output.wallNanoseconds = elapsed;
+	output.ticksPerSecond = elapsed > 0 ? ticks * 1e9 / elapsed : 0;
+	return output;
+}
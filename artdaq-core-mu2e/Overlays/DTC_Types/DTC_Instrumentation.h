@@ -0,0 +1,191 @@
+#ifndef artdaq_core_mu2e_Overlays_DTC_Types_DTC_Instrumentation_h
+#define artdaq_core_mu2e_Overlays_DTC_Types_DTC_Instrumentation_h
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Hot-path instrumentation is compiled in when DTC_INSTRUMENTATION is defined (CMake option
+// ARTDAQ_CORE_MU2E_INSTRUMENTATION). Otherwise the macros expand to nothing, and DTC_Instrumentation::Snapshot()
+// returns empty statistics.
+#ifdef DTC_INSTRUMENTATION
+#define DTC_INSTRUMENT_SCOPE(name, stage) DTCLib::DTC_StageTimer name(DTCLib::DTC_InstrumentationStage::stage)
+#define DTC_INSTRUMENT_ADD(name, bytes, items) name.Add(bytes, items)
+#else
+#define DTC_INSTRUMENT_SCOPE(name, stage) \
+	do                                    \
+	{                                     \
+	} while (0)
+#define DTC_INSTRUMENT_ADD(name, bytes, items) \
+	do                                         \
+	{                                          \
+	} while (0)
+#endif
+
+namespace DTCLib {
+
+/// <summary>
+/// Instrumented stages of event parsing and decoding
+/// </summary>
+enum class DTC_InstrumentationStage : uint8_t
+{
+	SetupEvent,         ///< DTC_Event::SetupEvent; bytes of the event, items are subevents
+	SetupSubEvent,      ///< DTC_SubEvent::SetupSubEvent; bytes of the subevent, items are ROC blocks
+	HeaderDecode,       ///< Decoding a DTC_DataHeaderPacket from a DTC_DataPacket
+	TrackerDecode,      ///< TrackerDataDecoder::GetTrackerData; bytes of the block, items are hits
+	CalorimeterDecode,  ///< CalorimeterDataDecoder hit decoding; bytes of the block, items are hits
+	CRVDecode,          ///< CRVDataDecoder::GetCRVHits; bytes of the block, items are hits
+	Count
+};
+
+constexpr size_t DTC_InstrumentationStageCount = static_cast<size_t>(DTC_InstrumentationStage::Count);
+
+/// <summary>
+/// Get the name of an instrumented stage
+/// </summary>
+const char* DTC_InstrumentationStageName(DTC_InstrumentationStage stage);
+
+/// <summary>
+/// Accumulated counters of one stage. Latencies are measured in ticks of DTC_Instrumentation::Now(), which is the CPU
+/// time stamp counter where available.
+/// </summary>
+struct DTC_StageStats
+{
+	/// Bucket 0 holds latencies of 0 ticks, bucket i > 0 latencies in [2^(i-1), 2^i) ticks. The last bucket also holds
+	/// all longer latencies.
+	static constexpr size_t kHistogramBuckets = 48;
+
+	uint64_t calls{0};                                    ///< Number of times the stage ran
+	uint64_t bytes{0};                                    ///< Bytes processed
+	uint64_t items{0};                                    ///< Items (subevents, blocks, hits) produced
+	uint64_t ticks{0};                                    ///< Total time spent in the stage
+	std::array<uint64_t, kHistogramBuckets> latency{};  ///< Log2-bucketed histogram of per-call latency
+
+	/// <summary>
+	/// Get the histogram bucket of a latency
+	/// </summary>
+	static size_t Bucket(uint64_t ticks)
+	{
+		if (ticks == 0) return 0;
+		size_t bucket = 64 - __builtin_clzll(ticks);
+		return bucket < kHistogramBuckets ? bucket : kHistogramBuckets - 1;
+	}
+
+	/// <summary>
+	/// Get the upper bound, in ticks, of the histogram bucket containing the given fraction of calls
+	/// </summary>
+	/// <param name="fraction">Quantile, between 0 and 1 (e.g. 0.99)</param>
+	/// <returns>Upper bound of the bucket, 0 if there were no calls</returns>
+	uint64_t LatencyQuantile(double fraction) const;
+
+	DTC_StageStats& operator+=(DTC_StageStats const& other);
+	DTC_StageStats& operator-=(DTC_StageStats const& other);
+};
+
+/// <summary>
+/// Counters of all stages, summed over all threads, at one point in time. The difference of two snapshots gives the
+/// counters of the interval between them.
+/// </summary>
+struct DTC_InstrumentationSnapshot
+{
+	std::array<DTC_StageStats, DTC_InstrumentationStageCount> stages{};  ///< Counters, indexed by DTC_InstrumentationStage
+	uint64_t wallNanoseconds{0};                                           ///< Wall time covered by the counters
+	double ticksPerSecond{0};                                              ///< Rate of DTC_Instrumentation::Now()
+
+	/// <summary>
+	/// Get the counters of a stage
+	/// </summary>
+	DTC_StageStats const& operator[](DTC_InstrumentationStage stage) const { return stages[static_cast<size_t>(stage)]; }
+
+	/// <summary>
+	/// Get the total time spent in a stage, in seconds
+	/// </summary>
+	double BusySeconds(DTC_InstrumentationStage stage) const;
+	/// <summary>
+	/// Get the throughput of a stage while it was running, in bytes per second
+	/// </summary>
+	double BytesPerSecond(DTC_InstrumentationStage stage) const;
+	/// <summary>
+	/// Get the rate of calls to a stage over the wall time of the snapshot, in calls per second
+	/// </summary>
+	double CallsPerSecond(DTC_InstrumentationStage stage) const;
+	/// <summary>
+	/// Get a latency quantile of a stage, in seconds (upper bound of the histogram bucket)
+	/// </summary>
+	double LatencyQuantileSeconds(DTC_InstrumentationStage stage, double fraction) const;
+
+	/// <summary>
+	/// Get the counters accumulated since an earlier snapshot
+	/// </summary>
+	DTC_InstrumentationSnapshot operator-(DTC_InstrumentationSnapshot const& earlier) const;
+
+	/// <summary>
+	/// Serialize the snapshot as a JSON object, with calls, bytes, items, busy time, throughput, and the p50/p99
+	/// latencies of each stage
+	/// </summary>
+	std::string toJSON() const;
+};
+
+/// <summary>
+/// Per-thread hot-path counters. Each thread records into its own counters, so recording takes no lock and shares no
+/// cache lines; Snapshot() sums the counters of all threads, including threads which have exited.
+/// </summary>
+class DTC_Instrumentation
+{
+public:
+	/// <summary>
+	/// Whether the library was built with DTC_INSTRUMENTATION
+	/// </summary>
+	static bool Enabled();
+
+	/// <summary>
+	/// Read the tick counter used for latencies: the time stamp counter on x86, otherwise std::chrono::steady_clock
+	/// </summary>
+	static uint64_t Now();
+
+	/// <summary>
+	/// Record one call of a stage in the counters of the calling thread
+	/// </summary>
+	static void Record(DTC_InstrumentationStage stage, uint64_t ticks, uint64_t bytes, uint64_t items);
+
+	/// <summary>
+	/// Sum the counters of all threads. The wall time of the snapshot starts when the library was loaded.
+	/// </summary>
+	static DTC_InstrumentationSnapshot Snapshot();
+};
+
+/// <summary>
+/// Measures the scope it lives in and records it with DTC_Instrumentation on destruction. Use through the
+/// DTC_INSTRUMENT_SCOPE and DTC_INSTRUMENT_ADD macros, so that it is compiled out with instrumentation disabled.
+/// </summary>
+class DTC_StageTimer
+{
+public:
+	explicit DTC_StageTimer(DTC_InstrumentationStage stage)
+		: stage_(stage), start_(DTC_Instrumentation::Now()) {}
+	~DTC_StageTimer() { DTC_Instrumentation::Record(stage_, DTC_Instrumentation::Now() - start_, bytes_, items_); }
+
+	DTC_StageTimer(DTC_StageTimer const&) = delete;
+	DTC_StageTimer& operator=(DTC_StageTimer const&) = delete;
+
+	/// <summary>
+	/// Add to the bytes processed and items produced by this call
+	/// </summary>
+	void Add(uint64_t bytes, uint64_t items)
+	{
+		bytes_ += bytes;
+		items_ += items;
+	}
+
+private:
+	DTC_InstrumentationStage stage_;
+	uint64_t start_;
+	uint64_t bytes_{0};
+	uint64_t items_{0};
+};
+
+}  // namespace DTCLib
+
+#endif  // artdaq_core_mu2e_Overlays_DTC_Types_DTC_Instrumentation_h
@@ -0,0 +1,39 @@
+#include "artdaq-core-mu2e/Overlays/DTC_Types/DTC_JSONWriter.h"
+
+#include <charconv>
+
+namespace {
+void appendPadded(std::string& out, uint64_t value, int base, int width)
+{
+	char digits[24];
+	auto end = std::to_chars(digits, digits + sizeof(digits), value, base).ptr;
+	auto len = static_cast<int>(end - digits);
+	if (width > len) out.append(width - len, '0');
+	out.append(digits, len);
+}
+}  // namespace
+
+DTCLib::DTC_JSONWriter& DTCLib::DTC_JSONWriter::Dec(uint64_t value, int width)
+{
+	appendPadded(out_, value, 10, width);
+	return *this;
+}
+
+DTCLib::DTC_JSONWriter& DTCLib::DTC_JSONWriter::Hex(uint64_t value, int width)
+{
+	appendPadded(out_, value, 16, width);
+	return *this;
+}
+
+DTCLib::DTC_JSONWriter& DTCLib::DTC_JSONWriter::BeginObject(std::string_view name)
+{
+	first_ = true;
+	return Raw("\"").Raw(name).Raw("\": {\n");
+}
+
+DTCLib::DTC_JSONWriter& DTCLib::DTC_JSONWriter::Key(std::string_view name)
+{
+	Raw(first_ ? "\t\"" : ",\n\t\"").Raw(name).Raw("\": ");
+	first_ = false;
+	return *this;
+}
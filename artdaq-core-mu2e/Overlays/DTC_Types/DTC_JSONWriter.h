@@ -0,0 +1,82 @@
+#ifndef artdaq_core_mu2e_Overlays_DTC_Types_DTC_JSONWriter_h
+#define artdaq_core_mu2e_Overlays_DTC_Types_DTC_JSONWriter_h
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace DTCLib {
+
+/// <summary>
+/// Appends the JSON and "packet format" representations of DTC and CFO packets and headers to a caller-owned
+/// std::string. Numbers are formatted with std::to_chars, so no stream objects are created; reusing the same string
+/// (clear() keeps its capacity) makes serialization allocation-free once the string has grown to size.
+/// Used by the DMA packet header, DTC_DataHeaderPacket, DTC_DataPacket, DTC_EventWindowTag and the event, subevent
+/// and CFO event record headers. The DCS Request/Reply, Heartbeat and Data Request packets, and the CFO packets,
+/// still format with std::stringstream.
+/// </summary>
+class DTC_JSONWriter
+{
+public:
+	/// <summary>
+	/// Construct a DTC_JSONWriter appending to the given string
+	/// </summary>
+	/// <param name="out">String to append to. Existing contents are kept</param>
+	explicit DTC_JSONWriter(std::string& out)
+		: out_(out) {}
+
+	/// <summary>
+	/// Append text as-is
+	/// </summary>
+	DTC_JSONWriter& Raw(std::string_view text)
+	{
+		out_.append(text.data(), text.size());
+		return *this;
+	}
+	/// <summary>
+	/// Append a number in decimal, zero-padded to width digits
+	/// </summary>
+	DTC_JSONWriter& Dec(uint64_t value, int width = 0);
+	/// <summary>
+	/// Append a number in lower-case hexadecimal without prefix, zero-padded to width digits
+	/// </summary>
+	DTC_JSONWriter& Hex(uint64_t value, int width = 0);
+	/// <summary>
+	/// Append a number as "0x" followed by lower-case hexadecimal, zero-padded to width digits
+	/// </summary>
+	DTC_JSONWriter& PrefixedHex(uint64_t value, int width = 0) { return Raw("0x").Hex(value, width); }
+
+	/// <summary>
+	/// Open a named object: "name": {
+	/// </summary>
+	DTC_JSONWriter& BeginObject(std::string_view name);
+	/// <summary>
+	/// Start a member of the current object, with the separator from the previous member: "name":
+	/// </summary>
+	DTC_JSONWriter& Key(std::string_view name);
+	/// <summary>
+	/// Close the current object
+	/// </summary>
+	DTC_JSONWriter& EndObject()
+	{
+		first_ = false;
+		return Raw("\n}");
+	}
+
+	/// <summary>
+	/// Append a member with a decimal value
+	/// </summary>
+	DTC_JSONWriter& Field(std::string_view name, uint64_t value) { return Key(name).Dec(value); }
+	/// <summary>
+	/// Append a member with a "0x"-prefixed hexadecimal value
+	/// </summary>
+	DTC_JSONWriter& HexField(std::string_view name, uint64_t value) { return Key(name).PrefixedHex(value); }
+
+private:
+	std::string& out_;
+	bool first_{true};  ///< No member has been written to the current object yet
+};
+
+}  // namespace DTCLib
+
+#endif  // artdaq_core_mu2e_Overlays_DTC_Types_DTC_JSONWriter_h
@@ -1,5 +1,7 @@
 #include "artdaq-core-mu2e/Overlays/DTC_Types/Utilities.h"
 
+#include "artdaq-core-mu2e/Overlays/DTC_Types/DTC_HexDump.h"
+
 #include "TRACE/tracemf.h"
 
 #include <cmath>
@@ -151,24 +153,23 @@ std::pair<double, std::string> DTCLib::Utilities::FormatTime(double seconds)
 
 void DTCLib::Utilities::PrintBuffer(const void* ptr, size_t sz, size_t quietCount, int tlvl)
 {
-	auto maxLine = static_cast<unsigned>(ceil((sz) / 16.0));
-	for (unsigned line = 0; line < maxLine; ++line)
+	DTC_HexDump::Options options;
+	options.quietCount = quietCount;
+	DTC_HexDump dump(ptr, sz, options);
+
+	// Lines are formatted in chunks straight into a stack buffer, and only if the TLOG level is enabled
+	char buffer[32 * DTC_HexDump::kMaxLineLength];
+	while (!dump.Done())
 	{
-		std::stringstream ostr;
-		ostr << "0x" << std::hex << std::setw(5) << std::setfill('0') << line << "0: ";
-		for (unsigned byte = 0; byte < 8; ++byte)
-		{
-			if (line * 16 + 2 * byte < sz)
-			{
-				auto thisWord = reinterpret_cast<const uint16_t*>(ptr)[line * 8 + byte];
-				ostr << std::setw(4) << static_cast<int>(thisWord) << " ";
-			}
-		}
-		TLOG(tlvl) << ostr.str();
-		if (quietCount > 0 && maxLine > quietCount * 2 && line == (quietCount - 1))
-		{
-			line = static_cast<unsigned>(ceil((sz) / 16.0)) - (1 + quietCount);
-		}
+		bool active = false;
+		auto formatChunk = [&]() {
+			active = true;
+			auto len = dump.FormatNext(buffer, sizeof(buffer));
+			buffer[len - 1] = '\0';  // Replaces the final newline, which TLOG adds
+			return static_cast<const char*>(buffer);
+		};
+		TLOG(tlvl) << formatChunk();
+		if (!active) return;
 	}
 }
 
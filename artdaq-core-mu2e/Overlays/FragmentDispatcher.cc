@@ -0,0 +1,66 @@
+#include "artdaq-core-mu2e/Overlays/FragmentDispatcher.hh"
+
+#include "TRACE/tracemf.h"
+
+#include <algorithm>
+
+void mu2e::FragmentDispatcher::reportUnhandled(type_t type, size_t count)
+{
+	unhandled_ += count;
+	auto name = fragmentTypeName(static_cast<FragmentType>(type));
+	TLOG(TLVL_DEBUG + 5, "FragmentDispatcher") << "No handler for " << count << " Fragment(s) of type " << static_cast<int>(type) << " ("
+											   << (name.empty() ? std::string_view("unknown") : name) << ")";
+}
+
+size_t mu2e::FragmentDispatcher::decode(artdaq::Fragments const& fragments)
+{
+	if (fragments.empty()) return 0;
+
+	// Counting sort by type: count each type, turn the counts into group offsets, then place each Fragment
+	std::fill(offsets_.begin(), offsets_.end(), 0);
+	for (auto const& frag : fragments)
+	{
+		++offsets_[frag.type() + 1];
+	}
+	for (size_t type = 0; type < kTypeCount; ++type)
+	{
+		offsets_[type + 1] += offsets_[type];
+	}
+
+	sorted_.resize(fragments.size());
+	auto next = offsets_;
+	for (auto const& frag : fragments)
+	{
+		sorted_[next[frag.type()]++] = &frag;
+	}
+
+	size_t dispatched = 0;
+	for (size_t type = 0; type < kTypeCount; ++type)
+	{
+		auto count = offsets_[type + 1] - offsets_[type];
+		if (count == 0) continue;
+
+		auto const& entry = handlers_[type];
+		if (entry.handler == nullptr)
+		{
+			reportUnhandled(static_cast<type_t>(type), count);
+			continue;
+		}
+		entry.handler(entry.context, sorted_.data() + offsets_[type], count);
+		dispatched += count;
+	}
+	return dispatched;
+}
+
+bool mu2e::FragmentDispatcher::decode(artdaq::Fragment const& fragment)
+{
+	auto const& entry = handlers_[fragment.type()];
+	if (entry.handler == nullptr)
+	{
+		reportUnhandled(fragment.type(), 1);
+		return false;
+	}
+	auto ptr = &fragment;
+	entry.handler(entry.context, &ptr, 1);
+	return true;
+}
@@ -0,0 +1,114 @@
+#ifndef mu2e_artdaq_core_Overlays_FragmentDispatcher_hh
+#define mu2e_artdaq_core_Overlays_FragmentDispatcher_hh
+
+#include "artdaq-core-mu2e/Overlays/FragmentType.hh"
+#include "artdaq-core/Data/Fragment.hh"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace mu2e {
+
+/// <summary>
+/// Routes artdaq::Fragments to decoders by Fragment type, replacing hand-written switches on FragmentType.
+/// decode() groups a batch of Fragments by type (a stable counting sort into a reused index buffer) and hands each
+/// group to its handler in one call, so each decoder runs over all of its Fragments back to back. Handlers are plain
+/// function pointers with a context pointer; after the first batch, dispatch does not allocate.
+/// The built-in decoders of the Mu2e Fragment types are registered with registerFragmentDecoders
+/// (artdaq-core-mu2e/Data/FragmentDecoders.hh).
+/// </summary>
+class FragmentDispatcher
+{
+public:
+	using type_t = artdaq::Fragment::type_t;
+
+	/// <summary>
+	/// Group handler: called once per type per batch, with the Fragments of that type in their original order
+	/// </summary>
+	using Handler = void (*)(void* context, artdaq::Fragment const* const* fragments, size_t count);
+
+	/// <summary>
+	/// Register a group handler for a Fragment type, replacing any previous one
+	/// </summary>
+	/// <param name="type">Fragment type</param>
+	/// <param name="handler">Handler function (nullptr unregisters the type)</param>
+	/// <param name="context">Passed to the handler unchanged; must outlive the registration</param>
+	void registerHandler(type_t type, Handler handler, void* context = nullptr)
+	{
+		handlers_[type] = {handler, handler ? context : nullptr};
+	}
+
+	/// <summary>
+	/// Register a decoder object for a Fragment type. The decoder is called as decoder(fragment) for each Fragment of
+	/// the group, and is held by reference, so it must outlive the registration.
+	/// </summary>
+	/// <typeparam name="Decoder">Type callable with an artdaq::Fragment const&</typeparam>
+	/// <param name="type">Fragment type</param>
+	/// <param name="decoder">Decoder object</param>
+	template<typename Decoder>
+	void registerDecoder(type_t type, Decoder& decoder)
+	{
+		registerHandler(
+			type, [](void* context, artdaq::Fragment const* const* fragments, size_t count) {
+				auto& dec = *static_cast<Decoder*>(context);
+				for (size_t ii = 0; ii < count; ++ii)
+				{
+					dec(*fragments[ii]);
+				}
+			},
+			&decoder);
+	}
+
+	/// <summary>
+	/// Remove the handler for a Fragment type
+	/// </summary>
+	void unregister(type_t type) { handlers_[type] = {}; }
+
+	/// <summary>
+	/// Whether a handler is registered for a Fragment type
+	/// </summary>
+	bool isRegistered(type_t type) const { return handlers_[type].handler != nullptr; }
+
+	/// <summary>
+	/// Dispatch a batch of Fragments. Groups are handled in ascending type order.
+	/// Fragments with no registered handler are skipped and counted in unhandledCount().
+	/// </summary>
+	/// <param name="fragments">Fragments to decode</param>
+	/// <returns>Number of Fragments passed to a handler</returns>
+	size_t decode(artdaq::Fragments const& fragments);
+
+	/// <summary>
+	/// Dispatch a single Fragment
+	/// </summary>
+	/// <param name="fragment">Fragment to decode</param>
+	/// <returns>Whether a handler was registered for its type</returns>
+	bool decode(artdaq::Fragment const& fragment);
+
+	/// <summary>
+	/// Get the number of Fragments skipped because no handler was registered for their type
+	/// </summary>
+	size_t unhandledCount() const { return unhandled_; }
+
+private:
+	static constexpr size_t kTypeCount = size_t(std::numeric_limits<type_t>::max()) + 1;
+
+	struct Entry
+	{
+		Handler handler{nullptr};
+		void* context{nullptr};
+	};
+
+	void reportUnhandled(type_t type, size_t count);
+
+	std::array<Entry, kTypeCount> handlers_{};
+	std::array<uint32_t, kTypeCount + 1> offsets_{};  ///< Start of each type's group in sorted_
+	std::vector<artdaq::Fragment const*> sorted_;     ///< Fragments of the current batch, grouped by type
+	size_t unhandled_{0};
+};
+
+}  // namespace mu2e
+
+#endif  // mu2e_artdaq_core_Overlays_FragmentDispatcher_hh
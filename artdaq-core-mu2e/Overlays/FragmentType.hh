@@ -1,6 +1,12 @@
 #ifndef mu2e_artdaq_core_Overlays_FragmentType_hh
 #define mu2e_artdaq_core_Overlays_FragmentType_hh
 #include "artdaq-core/Data/Fragment.hh"
+
+#include <array>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <string_view>
 #include <unordered_map>
 
 namespace mu2e {
@@ -19,7 +25,7 @@ enum FragmentType : artdaq::Fragment::type_t
 	DBG    = artdaq::Fragment::FirstUserFragmentType + 7,     // Debug Packet Fragment
 	DTCEVT = artdaq::Fragment::FirstUserFragmentType + 8,  // DTC Event Fragment
 	STM    = artdaq::Fragment::FirstUserFragmentType + 9,     // Stopping Target Monitor fragment
-  TRKDTC = artdaq::Fragment::FirstUserFragmentType +10,     // hardware debug info
+	TRKDTC = artdaq::Fragment::FirstUserFragmentType + 10,    // hardware debug info
 	INVALID  // Should always be last.
 };
 
@@ -29,7 +35,17 @@ static_assert(artdaq::Fragment::isUserFragmentType(FragmentType::INVALID - 1), "
 
 using detail::FragmentType;
 
-std::unordered_map<FragmentType, std::string> const names{
+/// <summary>
+/// Name of each Fragment type defined by this package. This constexpr table is the single source for all
+/// name/type conversions below.
+/// </summary>
+struct FragmentTypeName
+{
+	FragmentType type;
+	std::string_view name;
+};
+
+inline constexpr std::array<FragmentTypeName, 8> fragmentTypeNames{{
 	{FragmentType::MISSED, "MISSED"},
 	//{FragmentType::DTC, "DTC"},   // DEPRECATED
 	//{FragmentType::MU2E, "MU2E"}, // DEPRECATED
@@ -39,11 +55,111 @@ std::unordered_map<FragmentType, std::string> const names{
 	{FragmentType::CRV   , "CRV"   },
 	{FragmentType::DBG   , "DBG"   },
 	{FragmentType::DTCEVT, "DTCEVT"},
-  {FragmentType::STM   , "STM"   },
-  {FragmentType::TRKDTC, "TRKDTC"},
-};
+	{FragmentType::STM   , "STM"   },
+	{FragmentType::TRKDTC, "TRKDTC"},
+}};
+
+/// <summary>
+/// Map of Fragment type names, built once from fragmentTypeNames. Kept for compatibility; prefer
+/// fragmentTypeName() and toFragmentType().
+/// </summary>
+extern std::unordered_map<FragmentType, std::string> const names;
+
+namespace detail {
+constexpr char toUpper(char c) { return c >= 'a' && c <= 'z' ? c - 'a' + 'A' : c; }
+
+// FNV-1a over the upper-cased name, with a seed chosen at compile time to make the table below collision-free
+constexpr uint32_t nameHash(std::string_view name, uint32_t seed)
+{
+	uint32_t hash = 2166136261u ^ seed;
+	for (auto c : name)
+	{
+		hash = (hash ^ static_cast<uint8_t>(toUpper(c))) * 16777619u;
+	}
+	return hash;
+}
+
+constexpr size_t nameTableSize = 16;  // Power of two, at least twice the number of names
+
+constexpr bool seedIsPerfect(uint32_t seed)
+{
+	bool used[nameTableSize] = {};
+	for (auto const& entry : fragmentTypeNames)
+	{
+		auto slot = nameHash(entry.name, seed) % nameTableSize;
+		if (used[slot]) return false;
+		used[slot] = true;
+	}
+	return true;
+}
+
+constexpr uint32_t findPerfectSeed()
+{
+	uint32_t seed = 0;
+	while (!seedIsPerfect(seed)) ++seed;
+	return seed;
+}
+
+constexpr uint32_t nameSeed = findPerfectSeed();
+
+constexpr std::array<uint8_t, nameTableSize> makeNameTable()
+{
+	std::array<uint8_t, nameTableSize> table{};
+	for (auto& slot : table) slot = 0xFF;
+	for (size_t ii = 0; ii < fragmentTypeNames.size(); ++ii)
+	{
+		table[nameHash(fragmentTypeNames[ii].name, nameSeed) % nameTableSize] = static_cast<uint8_t>(ii);
+	}
+	return table;
+}
+
+constexpr std::array<uint8_t, nameTableSize> nameTable = makeNameTable();  ///< Hash slot -> index in fragmentTypeNames
+
+constexpr std::array<std::string_view, FragmentType::INVALID + 1> makeTypeTable()
+{
+	std::array<std::string_view, FragmentType::INVALID + 1> table{};
+	for (auto const& entry : fragmentTypeNames)
+	{
+		table[entry.type] = entry.name;
+	}
+	return table;
+}
+
+constexpr std::array<std::string_view, FragmentType::INVALID + 1> typeTable = makeTypeTable();  ///< Type -> name
+
+constexpr bool equalsIgnoreCase(std::string_view a, std::string_view b)
+{
+	if (a.size() != b.size()) return false;
+	for (size_t ii = 0; ii < a.size(); ++ii)
+	{
+		if (toUpper(a[ii]) != toUpper(b[ii])) return false;
+	}
+	return true;
+}
+}  // namespace detail
+
+/// <summary>
+/// Get the name of a Fragment type
+/// </summary>
+/// <param name="val">Fragment type</param>
+/// <returns>Name of the type, or an empty string_view if it is not a type defined by this package</returns>
+constexpr std::string_view fragmentTypeName(FragmentType val)
+{
+	return val < detail::typeTable.size() ? detail::typeTable[val] : std::string_view();
+}
+
+/// <summary>
+/// Convert a (case-insensitive) Fragment type name to a FragmentType, using a perfect hash
+/// </summary>
+/// <param name="t_string">Name of the Fragment type</param>
+/// <returns>FragmentType, or FragmentType::INVALID if the name is unknown</returns>
+constexpr FragmentType toFragmentType(std::string_view t_string)
+{
+	auto idx = detail::nameTable[detail::nameHash(t_string, detail::nameSeed) % detail::nameTableSize];
+	if (idx < fragmentTypeNames.size() && detail::equalsIgnoreCase(fragmentTypeNames[idx].name, t_string)) return fragmentTypeNames[idx].type;
+	return FragmentType::INVALID;
+}
 
-FragmentType toFragmentType(std::string t_string);
 std::string fragmentTypeToString(FragmentType val);
 
 /**
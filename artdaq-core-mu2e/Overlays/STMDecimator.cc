@@ -0,0 +1,239 @@
+#include "artdaq-core-mu2e/Overlays/STMDecimator.hh"
+
+#include "TRACE/tracemf.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace {
+int16_t clampToADC(float value)
+{
+	return static_cast<int16_t>(std::lrint(std::min<float>(INT16_MAX, std::max<float>(INT16_MIN, value))));
+}
+
+int16_t roundedMean(int32_t sum, uint32_t count)
+{
+	auto half = static_cast<int32_t>(count / 2);
+	return static_cast<int16_t>((sum >= 0 ? sum + half : sum - half) / static_cast<int32_t>(count));
+}
+
+int32_t sum16(int16_t const* adc, size_t n)
+{
+	int32_t sum = 0;
+	size_t ii = 0;
+#if defined(__SSE2__)
+	auto ones = _mm_set1_epi16(1);
+	auto acc = _mm_setzero_si128();
+	for (; ii + 8 <= n; ii += 8)
+	{
+		acc = _mm_add_epi32(acc, _mm_madd_epi16(_mm_loadu_si128(reinterpret_cast<__m128i const*>(adc + ii)), ones));
+	}
+	acc = _mm_add_epi32(acc, _mm_shuffle_epi32(acc, _MM_SHUFFLE(1, 0, 3, 2)));
+	acc = _mm_add_epi32(acc, _mm_shuffle_epi32(acc, _MM_SHUFFLE(2, 3, 0, 1)));
+	sum = _mm_cvtsi128_si32(acc);
+#endif
+	for (; ii < n; ++ii) sum += adc[ii];
+	return sum;
+}
+
+void toFloat(int16_t const* adc, size_t n, float* out)
+{
+	size_t ii = 0;
+#if defined(__SSE2__)
+	for (; ii + 8 <= n; ii += 8)
+	{
+		auto x = _mm_loadu_si128(reinterpret_cast<__m128i const*>(adc + ii));
+		auto lo = _mm_srai_epi32(_mm_unpacklo_epi16(x, x), 16);
+		auto hi = _mm_srai_epi32(_mm_unpackhi_epi16(x, x), 16);
+		_mm_storeu_ps(out + ii, _mm_cvtepi32_ps(lo));
+		_mm_storeu_ps(out + ii + 4, _mm_cvtepi32_ps(hi));
+	}
+#endif
+	for (; ii < n; ++ii) out[ii] = adc[ii];
+}
+
+float dot(float const* a, float const* b, size_t n)
+{
+	float sum = 0;
+	size_t ii = 0;
+#if defined(__SSE2__)
+	auto acc = _mm_setzero_ps();
+	for (; ii + 4 <= n; ii += 4)
+	{
+		acc = _mm_add_ps(acc, _mm_mul_ps(_mm_loadu_ps(a + ii), _mm_loadu_ps(b + ii)));
+	}
+	float partial[4];
+	_mm_storeu_ps(partial, acc);
+	sum = (partial[0] + partial[1]) + (partial[2] + partial[3]);
+#endif
+	for (; ii < n; ++ii) sum += a[ii] * b[ii];
+	return sum;
+}
+}  // namespace
+
+mu2e::STMDecimator::STMDecimator(Config const& config)
+	: config_(config)
+	, reversedTaps_(config.taps.rbegin(), config.taps.rend())
+{
+	if (config_.factor == 0)
+	{
+		throw std::invalid_argument("STMDecimator: decimation factor must be at least 1");
+	}
+	if (config_.mode == Mode::FIR && config_.taps.empty())
+	{
+		throw std::invalid_argument("STMDecimator: FIR mode requires at least one tap");
+	}
+	Reset();
+}
+
+void mu2e::STMDecimator::Reset()
+{
+	primed_ = false;
+	nextTime_ = 0;
+	boxSum_ = 0;
+	boxCount_ = 0;
+	window_.clear();
+	history_ = 0;
+	phase_ = reversedTaps_.empty() ? 0 : reversedTaps_.size() - 1;
+}
+
+uint64_t mu2e::STMDecimator::GetNextOutputTime() const
+{
+	if (config_.mode == Mode::Boxcar)
+	{
+		return nextTime_ + (config_.factor - boxCount_) - 1;
+	}
+	return nextTime_ + phase_ - history_;
+}
+
+size_t mu2e::STMDecimator::Process(STMFragment::STMSlice const& slice, int16_t* out, size_t capacity)
+{
+	bool full = false;
+	auto written = ProcessSlice(slice, out, capacity, full);
+	if (full)
+	{
+		TLOG(TLVL_WARNING, "STMDecimator") << "Output buffer full (" << capacity << " samples), dropping the rest of the slice";
+	}
+	return written;
+}
+
+size_t mu2e::STMDecimator::ProcessSlice(STMFragment::STMSlice const& slice, int16_t* out, size_t capacity, bool& full)
+{
+	if (slice.hdr == nullptr) return 0;
+
+	auto const sliceTime = slice.hdr->adcTime();
+	if (primed_ && sliceTime != nextTime_)
+	{
+		TLOG(TLVL_DEBUG + 5, "STMDecimator") << "Slice " << slice.hdr->sliceNumber() << " starts at ADC time " << sliceTime << ", expected " << nextTime_ << "; resetting filter";
+		Reset();
+	}
+
+	auto adc = reinterpret_cast<int16_t const*>(slice.begin);
+	size_t const nSamples = slice.size();
+	auto written = config_.mode == Mode::Boxcar ? ProcessBoxcar(adc, nSamples, out, capacity, full) : ProcessFIR(adc, nSamples, out, capacity, full);
+
+	if (primed_)
+	{
+		nextTime_ = sliceTime + nSamples;
+	}
+	return written;
+}
+
+size_t mu2e::STMDecimator::Process(STMFragment const& fragment, int16_t* out, size_t capacity)
+{
+	size_t written = 0;
+	size_t truncated = 0;
+	for (auto const& slice : fragment)
+	{
+		bool full = false;
+		written += ProcessSlice(slice, out + written, capacity - written, full);
+		if (full) ++truncated;
+	}
+	if (truncated > 0)
+	{
+		TLOG(TLVL_WARNING, "STMDecimator") << "Output buffer full (" << capacity << " samples), dropped the rest of " << truncated << " slice(s)";
+	}
+	return written;
+}
+
+size_t mu2e::STMDecimator::ProcessBoxcar(int16_t const* adc, size_t nSamples, int16_t* out, size_t capacity, bool& full)
+{
+	auto const factor = config_.factor;
+	size_t written = 0;
+	size_t ii = 0;
+
+	// Complete a group left over from the previous slice
+	if (boxCount_ > 0)
+	{
+		auto n = std::min<size_t>(factor - boxCount_, nSamples);
+		boxSum_ += sum16(adc, n);
+		boxCount_ += n;
+		ii = n;
+	}
+
+	while (boxCount_ == factor || ii + factor <= nSamples)
+	{
+		if (written == capacity)
+		{
+			full = true;
+			Reset();
+			return written;
+		}
+		if (boxCount_ == factor)
+		{
+			out[written++] = roundedMean(boxSum_, factor);
+			boxSum_ = 0;
+			boxCount_ = 0;
+		}
+		else
+		{
+			out[written++] = roundedMean(sum16(adc + ii, factor), factor);
+			ii += factor;
+		}
+	}
+
+	if (ii < nSamples)
+	{
+		boxSum_ += sum16(adc + ii, nSamples - ii);
+		boxCount_ += nSamples - ii;
+	}
+	primed_ = true;
+	return written;
+}
+
+size_t mu2e::STMDecimator::ProcessFIR(int16_t const* adc, size_t nSamples, int16_t* out, size_t capacity, bool& full)
+{
+	auto const factor = config_.factor;
+	auto const nTaps = reversedTaps_.size();
+
+	window_.resize(history_ + nSamples);
+	toFloat(adc, nSamples, window_.data() + history_);
+
+	size_t written = 0;
+	size_t pos = phase_;
+	for (; pos < window_.size(); pos += factor)
+	{
+		if (written == capacity)
+		{
+			full = true;
+			Reset();
+			return written;
+		}
+		out[written++] = clampToADC(dot(reversedTaps_.data(), window_.data() + pos + 1 - nTaps, nTaps));
+	}
+
+	// Keep the last nTaps - 1 samples as history for the next slice
+	auto keep = std::min(nTaps - 1, window_.size());
+	auto shift = window_.size() - keep;
+	std::copy(window_.begin() + shift, window_.end(), window_.begin());
+	window_.resize(keep);
+	history_ = keep;
+	phase_ = pos - shift;
+	primed_ = true;
+	return written;
+}
@@ -0,0 +1,101 @@
+#ifndef MU2E_ARTDAQ_CORE_OVERLAYS_STMDECIMATOR_HH
+#define MU2E_ARTDAQ_CORE_OVERLAYS_STMDECIMATOR_HH
+
+#include "artdaq-core-mu2e/Overlays/STMFragment.hh"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace mu2e {
+
+/// <summary>
+/// Streaming decimator for STM ADC data, for online monitoring at a reduced sample rate. Reads slices in place
+/// and writes the decimated waveform into a caller-provided buffer. Filter state is carried from one slice to the
+/// next as long as the slices are contiguous in ADC time, and reset otherwise.
+/// ADC words are interpreted as signed 16-bit samples.
+/// </summary>
+class STMDecimator
+{
+public:
+	enum class Mode
+	{
+		Boxcar,  ///< Average of each group of factor samples
+		FIR,     ///< Arbitrary FIR filter evaluated at every factor-th sample
+	};
+
+	struct Config
+	{
+		uint32_t factor{8};        ///< Decimation factor; one output sample per factor input samples
+		Mode mode{Mode::Boxcar};
+		std::vector<float> taps;  ///< FIR coefficients, taps[0] applies to the newest sample (FIR mode only)
+	};
+
+	/// <summary>
+	/// Construct an STMDecimator
+	/// </summary>
+	/// <param name="config">Decimator configuration. Throws std::invalid_argument if factor is 0 or FIR mode has no taps</param>
+	explicit STMDecimator(Config const& config);
+
+	/// <summary>
+	/// Decimate a slice. If the slice does not follow the previous one in ADC time, the filter state is reset first.
+	/// </summary>
+	/// <param name="slice">Slice to decimate</param>
+	/// <param name="out">Output buffer</param>
+	/// <param name="capacity">Capacity of out, in samples. Samples which do not fit are dropped and the filter is reset.</param>
+	/// <returns>Number of samples written to out</returns>
+	size_t Process(STMFragment::STMSlice const& slice, int16_t* out, size_t capacity);
+
+	/// <summary>
+	/// Decimate every slice of a Fragment, writing the output of consecutive slices one after the other
+	/// </summary>
+	/// <param name="fragment">STMFragment to decimate</param>
+	/// <param name="out">Output buffer</param>
+	/// <param name="capacity">Capacity of out, in samples</param>
+	/// <returns>Number of samples written to out</returns>
+	size_t Process(STMFragment const& fragment, int16_t* out, size_t capacity);
+
+	/// <summary>
+	/// Discard the filter state. The next output sample will be computed from fresh input only.
+	/// </summary>
+	void Reset();
+
+	/// <summary>
+	/// ADC time of the input sample on which the next output sample will end. Only meaningful once a slice has
+	/// been processed since the last Reset.
+	/// </summary>
+	uint64_t GetNextOutputTime() const;
+
+	/// <summary>
+	/// Maximum number of output samples a slice of the given size can produce; use this to size output buffers
+	/// </summary>
+	size_t MaxOutputSize(size_t inputSamples) const { return inputSamples / config_.factor + 1; }
+
+	Config const& GetConfig() const { return config_; }
+
+private:
+	// Decimate one slice; full is set if the output buffer filled up and the rest of the slice was dropped, so that
+	// the caller warns once
+	size_t ProcessSlice(STMFragment::STMSlice const& slice, int16_t* out, size_t capacity, bool& full);
+	size_t ProcessBoxcar(int16_t const* adc, size_t nSamples, int16_t* out, size_t capacity, bool& full);
+	size_t ProcessFIR(int16_t const* adc, size_t nSamples, int16_t* out, size_t capacity, bool& full);
+
+	Config config_;
+	std::vector<float> reversedTaps_;  ///< taps in input order, so that each output is a contiguous dot product
+
+	bool primed_{false};   ///< True once a slice has been processed since the last Reset
+	uint64_t nextTime_{0};  ///< ADC time expected for the first sample of the next slice
+
+	// Boxcar state
+	int32_t boxSum_{0};
+	uint32_t boxCount_{0};
+
+	// FIR state
+	std::vector<float> window_;  ///< Input history followed by the current slice, converted to float
+	size_t history_{0};          ///< Number of history samples at the front of window_
+	size_t phase_{0};            ///< Index in window_ of the newest sample of the next output
+};
+
+}  // namespace mu2e
+
+#endif  // MU2E_ARTDAQ_CORE_OVERLAYS_STMDECIMATOR_HH
@@ -1,8 +1,74 @@
 #include "artdaq-core-mu2e/Overlays/STMFragment.hh"
 
+#include "TRACE/tracemf.h"
+
 // This is an overlay 
 std::ostream& operator<<(std::ostream& os, const mu2e::STMFragment::STM_tHdr& tHdr)
 {
 	os << std::dec << "Data size is " << ((tHdr.sw_tHdr[2] << 16) | tHdr.sw_tHdr[3]) << "\n Test word is " << std::hex << tHdr.sw_tHdr[0] << 16 << tHdr.sw_tHdr[1] << std::endl;
 	return os;
 }
+
+bool mu2e::STMFragment::ValidateSlices() const
+{
+	if (artdaq_fragment_.dataSizeBytes() < sizeof(STM_tHdr))
+	{
+		TLOG(TLVL_ERROR, "STMFragment") << "Fragment is too small to contain a trigger header (" << artdaq_fragment_.dataSizeBytes() << " bytes)";
+		return false;
+	}
+
+	auto first = reinterpret_cast<uint16_t const*>(GetTHdr() + 1);
+	auto expectedEnd = first + GetTHdr()->dataSize();
+	if (expectedEnd > PayloadEnd())
+	{
+		TLOG(TLVL_ERROR, "STMFragment") << "Trigger header data size " << GetTHdr()->dataSize() << " words exceeds Fragment payload of " << (PayloadEnd() - first) << " words";
+		return false;
+	}
+
+	uint16_t const* pos = first;
+	size_t nSlices = 0;
+	for (auto it = begin(); it != end() && it->end <= expectedEnd; ++it)
+	{
+		pos = it->end;
+		++nSlices;
+	}
+
+	if (pos != expectedEnd)
+	{
+		TLOG(TLVL_ERROR, "STMFragment") << "Slices end at word " << (pos - first) << " after " << nSlices << " slices, but trigger header data size is " << GetTHdr()->dataSize() << " words";
+		return false;
+	}
+	return true;
+}
+
+size_t mu2e::STMFragment::BuildSliceIndex() const
+{
+	slice_offsets_.clear();
+	auto first = reinterpret_cast<uint16_t const*>(GetTHdr() + 1);
+	for (auto it = begin(); it != end(); ++it)
+	{
+		slice_offsets_.push_back(reinterpret_cast<uint16_t const*>(it->hdr) - first);
+	}
+	return slice_offsets_.size();
+}
+
+size_t mu2e::STMFragment::GetSliceCount() const
+{
+	if (!slice_offsets_.empty()) return slice_offsets_.size();
+	return std::distance(begin(), end());
+}
+
+mu2e::STMFragment::STMSlice mu2e::STMFragment::GetSlice(size_t index) const
+{
+	if (!slice_offsets_.empty())
+	{
+		if (index >= slice_offsets_.size()) return STMSlice();
+		auto first = reinterpret_cast<uint16_t const*>(GetTHdr() + 1);
+		return *SliceIterator(first + slice_offsets_[index], PayloadEnd());
+	}
+
+	auto it = begin();
+	for (size_t ii = 0; ii < index && it != end(); ++ii) ++it;
+	if (it == end()) return STMSlice();
+	return *it;
+}
@@ -3,6 +3,10 @@
 
 #include "artdaq-core/Data/Fragment.hh"
 
+#include <cstddef>
+#include <iterator>
+#include <vector>
+
 namespace mu2e {
 class STMFragment
 {
@@ -128,29 +132,140 @@ public:
 		};
 	};
 
-	STM_tHdr const* GetTHdr()
+	/// <summary>
+	/// A single slice of STM data: its slice header and the ADC words that follow it, in place in the Fragment
+	/// </summary>
+	struct STMSlice
+	{
+		STM_sHdr const* hdr{nullptr};   ///< Slice header
+		uint16_t const* begin{nullptr};  ///< First ADC word of the slice
+		uint16_t const* end{nullptr};    ///< One past the last ADC word of the slice
+
+		size_t size() const { return end - begin; }
+	};
+
+	/// <summary>
+	/// Forward iterator over the slices of an STMFragment. Slices are walked in place using STM_sHdr::sliceSize();
+	/// iteration stops at the end of the Fragment payload, or at the first slice which does not fit in it.
+	/// </summary>
+	class SliceIterator
+	{
+	public:
+		using iterator_category = std::forward_iterator_tag;
+		using value_type = STMSlice;
+		using difference_type = std::ptrdiff_t;
+		using pointer = STMSlice const*;
+		using reference = STMSlice const&;
+
+		SliceIterator() {}
+		SliceIterator(uint16_t const* pos, uint16_t const* limit)
+			: limit_(limit)
+		{
+			load(pos);
+		}
+
+		reference operator*() const { return slice_; }
+		pointer operator->() const { return &slice_; }
+		SliceIterator& operator++()
+		{
+			load(slice_.end);
+			return *this;
+		}
+		SliceIterator operator++(int)
+		{
+			auto tmp = *this;
+			++(*this);
+			return tmp;
+		}
+		bool operator==(SliceIterator const& other) const { return slice_.hdr == other.slice_.hdr; }
+		bool operator!=(SliceIterator const& other) const { return !(*this == other); }
+
+	private:
+		void load(uint16_t const* pos)
+		{
+			slice_ = STMSlice();
+			if (pos == nullptr || limit_ - pos < sw_sHdr_words_) return;
+			auto hdr = reinterpret_cast<STM_sHdr const*>(pos);
+			auto data = pos + sw_sHdr_words_;
+			if (static_cast<size_t>(limit_ - data) < hdr->sliceSize()) return;  // Truncated slice
+			slice_.hdr = hdr;
+			slice_.begin = data;
+			slice_.end = data + hdr->sliceSize();
+		}
+
+		static constexpr std::ptrdiff_t sw_sHdr_words_ = sizeof(STM_sHdr) / sizeof(uint16_t);
+
+		STMSlice slice_;
+		uint16_t const* limit_{nullptr};
+	};
+
+	STM_tHdr const* GetTHdr() const
 	{
 		return reinterpret_cast<STM_tHdr const*>(artdaq_fragment_.dataBegin());
 	}
 
-	STM_sHdr const* GetSHdr() {
+	STM_sHdr const* GetSHdr() const {
 		return reinterpret_cast<STM_sHdr const*>(GetTHdr() + 1);
 	}
 
-	uint16_t const* DataBegin() {
+	uint16_t const* DataBegin() const {
 		return reinterpret_cast<uint16_t const*>(GetSHdr() + 1);
 	}
 
-	uint16_t const* DataEnd() {
+	uint16_t const* DataEnd() const {
 		return DataBegin() + GetSHdr()->sliceSize();
 	}
 
+	/// <summary>
+	/// Iterator to the first slice in the Fragment
+	/// </summary>
+	SliceIterator begin() const
+	{
+		return SliceIterator(reinterpret_cast<uint16_t const*>(GetTHdr() + 1), PayloadEnd());
+	}
+
+	/// <summary>
+	/// Iterator past the last complete slice in the Fragment
+	/// </summary>
+	SliceIterator end() const { return SliceIterator(); }
+
+	/// <summary>
+	/// Check that the slices in the Fragment are consistent with STM_tHdr::dataSize(), which is the number of
+	/// 16-bit words (slice headers and ADC words) following the trigger header
+	/// </summary>
+	/// <returns>True if the slices fill exactly dataSize() words and fit within the Fragment</returns>
+	bool ValidateSlices() const;
+
+	/// <summary>
+	/// Build the random-access slice index used by GetSlice. Only needed when slices are accessed out of order.
+	/// </summary>
+	/// <returns>Number of slices in the Fragment</returns>
+	size_t BuildSliceIndex() const;
+
+	/// <summary>
+	/// Get the number of complete slices in the Fragment. Uses the slice index if it has been built.
+	/// </summary>
+	size_t GetSliceCount() const;
+
+	/// <summary>
+	/// Get a slice by index. Uses the slice index if it has been built, otherwise walks the Fragment.
+	/// </summary>
+	/// <param name="index">Index of the slice</param>
+	/// <returns>STMSlice, with null pointers if index is out of range</returns>
+	STMSlice GetSlice(size_t index) const;
+
 	//	std::unique_ptr<STMBoardID> GetSTMBoardID(size_t blockIndex) const;
 	//	std::vector<std::pair<STMHitReadoutPacket, std::vector<uint16_t>>> GetSTMHits(size_t blockIndex) const;
 	//	std::vector<std::pair<STMHitReadoutPacket, uint16_t>> GetSTMHitsForTrigger(size_t blockIndex) const;
 
 private:
+	uint16_t const* PayloadEnd() const
+	{
+		return reinterpret_cast<uint16_t const*>(artdaq_fragment_.dataBeginBytes() + artdaq_fragment_.dataSizeBytes());
+	}
+
 	artdaq::Fragment const& artdaq_fragment_;
+	mutable std::vector<size_t> slice_offsets_;  ///< Word offsets of slice headers from the end of the trigger header
 };
 
 /*
@@ -0,0 +1,169 @@
+#include "artdaq-core-mu2e/Overlays/STMZeroSuppressor.hh"
+
+#include "TRACE/tracemf.h"
+
+#include <algorithm>
+#include <cstring>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace {
+int16_t clampToADC(int32_t value)
+{
+	return static_cast<int16_t>(std::min<int32_t>(INT16_MAX, std::max<int32_t>(INT16_MIN, value)));
+}
+}  // namespace
+
+mu2e::STMZeroSuppressor::STMZeroSuppressor(Config const& config)
+	: config_(config)
+	, high_(clampToADC(static_cast<int32_t>(config.baseline) + config.threshold))
+	, low_(clampToADC(static_cast<int32_t>(config.baseline) - config.threshold))
+{}
+
+uint32_t mu2e::STMZeroSuppressor::OverMask16(int16_t const* adc) const
+{
+#if defined(__SSE2__)
+	auto a = _mm_loadu_si128(reinterpret_cast<__m128i const*>(adc));
+	auto b = _mm_loadu_si128(reinterpret_cast<__m128i const*>(adc + 8));
+	__m128i ca, cb;
+	if (config_.negativePolarity)
+	{
+		auto lo = _mm_set1_epi16(low_);
+		ca = _mm_cmplt_epi16(a, lo);
+		cb = _mm_cmplt_epi16(b, lo);
+	}
+	else
+	{
+		auto hi = _mm_set1_epi16(high_);
+		ca = _mm_cmpgt_epi16(a, hi);
+		cb = _mm_cmpgt_epi16(b, hi);
+	}
+	return static_cast<uint32_t>(_mm_movemask_epi8(_mm_packs_epi16(ca, cb)));
+#else
+	uint32_t mask = 0;
+	for (int ii = 0; ii < 16; ++ii)
+	{
+		mask |= static_cast<uint32_t>(IsOver(adc[ii])) << ii;
+	}
+	return mask;
+#endif
+}
+
+void mu2e::STMZeroSuppressor::WarnPayloadFull(size_t zsCapacity, size_t noPayload) const
+{
+	if (noPayload == 0) return;
+	TLOG(TLVL_WARNING, "STMZeroSuppressor") << "Zero-suppressed payload buffer full (" << zsCapacity << " samples), " << noPayload << " pulse(s) stored without payload";
+}
+
+size_t mu2e::STMZeroSuppressor::FindPulses(STMFragment::STMSlice const& slice, std::vector<Pulse>& pulses, uint16_t* zsPayload, size_t zsCapacity) const
+{
+	size_t noPayload = 0;
+	auto written = ScanSlice(slice, pulses, zsPayload, zsCapacity, noPayload);
+	WarnPayloadFull(zsCapacity, noPayload);
+	return written;
+}
+
+size_t mu2e::STMZeroSuppressor::ScanSlice(STMFragment::STMSlice const& slice, std::vector<Pulse>& pulses, uint16_t* zsPayload, size_t zsCapacity, size_t& noPayload) const
+{
+	if (slice.hdr == nullptr) return 0;
+
+	auto adc = reinterpret_cast<int16_t const*>(slice.begin);
+	size_t const nSamples = slice.size();
+	uint64_t const sliceTime = slice.hdr->adcTime();
+	int64_t const sign = config_.negativePolarity ? -1 : 1;
+
+	size_t written = 0;
+	size_t windowEnd = 0;  // End of the last payload window, so that overlapping windows are not duplicated
+
+	auto closePulse = [&](Pulse& pulse) {
+		if (pulse.length < config_.minLength) return;
+		pulse.time = sliceTime + pulse.startSample;
+		if (zsPayload != nullptr)
+		{
+			size_t begin = pulse.startSample > config_.presamples ? pulse.startSample - config_.presamples : 0;
+			begin = std::max(begin, windowEnd);
+			size_t end = std::min<size_t>(nSamples, static_cast<size_t>(pulse.startSample) + pulse.length + config_.postsamples);
+			if (written + (end - begin) <= zsCapacity)
+			{
+				memcpy(zsPayload + written, slice.begin + begin, (end - begin) * sizeof(uint16_t));
+				pulse.payloadOffset = written;
+				pulse.payloadLength = end - begin;
+				written += end - begin;
+				windowEnd = end;
+			}
+			else
+			{
+				++noPayload;
+			}
+		}
+		pulses.push_back(pulse);
+	};
+
+	Pulse current;
+	bool inPulse = false;
+	size_t ii = 0;
+	while (ii < nSamples)
+	{
+		if (!inPulse && ii + 16 <= nSamples)
+		{
+			// Skip quiet stretches 16 samples at a time
+			auto mask = OverMask16(adc + ii);
+			if (mask == 0)
+			{
+				ii += 16;
+				continue;
+			}
+			ii += __builtin_ctz(mask);
+		}
+
+		auto sample = adc[ii];
+		if (IsOver(sample))
+		{
+			int64_t amplitude = sign * (static_cast<int64_t>(sample) - config_.baseline);
+			if (!inPulse)
+			{
+				inPulse = true;
+				current = Pulse();
+				current.startSample = ii;
+				current.peakSample = ii;
+				current.peak = sample;
+			}
+			else if (amplitude > sign * (static_cast<int64_t>(current.peak) - config_.baseline))
+			{
+				current.peakSample = ii;
+				current.peak = sample;
+			}
+			current.integral += amplitude;
+			++current.length;
+		}
+		else if (inPulse)
+		{
+			inPulse = false;
+			closePulse(current);
+		}
+		++ii;
+	}
+	if (inPulse) closePulse(current);
+
+	return written;
+}
+
+size_t mu2e::STMZeroSuppressor::FindPulses(STMFragment const& fragment, std::vector<Pulse>& pulses, uint16_t* zsPayload, size_t zsCapacity) const
+{
+	size_t written = 0;
+	size_t noPayload = 0;
+	for (auto const& slice : fragment)
+	{
+		auto firstPulse = pulses.size();
+		auto sliceWritten = ScanSlice(slice, pulses, zsPayload == nullptr ? nullptr : zsPayload + written, zsCapacity - written, noPayload);
+		for (auto ii = firstPulse; ii < pulses.size(); ++ii)
+		{
+			if (pulses[ii].payloadLength > 0) pulses[ii].payloadOffset += written;
+		}
+		written += sliceWritten;
+	}
+	WarnPayloadFull(zsCapacity, noPayload);
+	return written;
+}
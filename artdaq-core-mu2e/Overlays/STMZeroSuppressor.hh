@@ -0,0 +1,84 @@
+#ifndef MU2E_ARTDAQ_CORE_OVERLAYS_STMZEROSUPPRESSOR_HH
+#define MU2E_ARTDAQ_CORE_OVERLAYS_STMZEROSUPPRESSOR_HH
+
+#include "artdaq-core-mu2e/Overlays/STMFragment.hh"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace mu2e {
+
+/// <summary>
+/// Threshold pulse finder and zero suppressor for STM ADC slices. Scans a slice in place (16 samples at a time
+/// where SIMD is available) and emits one compact Pulse record per run of samples over threshold, optionally
+/// copying the samples of each pulse window into a caller-provided zero-suppressed buffer.
+/// ADC words are interpreted as signed 16-bit samples.
+/// </summary>
+class STMZeroSuppressor
+{
+public:
+	struct Config
+	{
+		int16_t baseline{0};         ///< Pedestal subtracted from each sample
+		int16_t threshold{100};      ///< A sample is in a pulse if its pedestal-subtracted amplitude exceeds this
+		bool negativePolarity{false};  ///< If true, pulses go below the baseline
+		uint16_t minLength{1};       ///< Pulses shorter than this many samples are discarded
+		uint16_t presamples{0};      ///< Samples before the pulse to keep in the zero-suppressed payload
+		uint16_t postsamples{0};     ///< Samples after the pulse to keep in the zero-suppressed payload
+	};
+
+	struct Pulse
+	{
+		uint32_t startSample{0};    ///< Index of the first sample over threshold within the slice
+		uint32_t length{0};         ///< Number of consecutive samples over threshold
+		uint32_t peakSample{0};     ///< Index of the sample with the largest amplitude within the slice
+		int16_t peak{0};            ///< Raw ADC value at peakSample
+		int64_t integral{0};        ///< Sum of pedestal-subtracted amplitudes (positive for either polarity)
+		uint64_t time{0};           ///< STM_sHdr::adcTime() + startSample, in ADC clock ticks
+		uint32_t payloadOffset{0};  ///< Offset of this pulse's window in the zero-suppressed payload
+		uint32_t payloadLength{0};  ///< Number of samples of this pulse's window in the payload (0 if not written)
+	};
+
+	explicit STMZeroSuppressor(Config const& config);
+
+	/// <summary>
+	/// Find pulses in a slice. Pulses are appended to the given vector, so that it can be reused between calls
+	/// without reallocation. A pulse still over threshold at the end of the slice is closed there. Pulses which no
+	/// longer fit in zsPayload are stored without payload, and counted in a single warning.
+	/// </summary>
+	/// <param name="slice">Slice to scan</param>
+	/// <param name="pulses">Output pulse records (appended)</param>
+	/// <param name="zsPayload">Optional buffer for the zero-suppressed payload (may be nullptr)</param>
+	/// <param name="zsCapacity">Capacity of zsPayload, in samples</param>
+	/// <returns>Number of samples written to zsPayload</returns>
+	size_t FindPulses(STMFragment::STMSlice const& slice, std::vector<Pulse>& pulses, uint16_t* zsPayload = nullptr, size_t zsCapacity = 0) const;
+
+	/// <summary>
+	/// Find pulses in every slice of a Fragment. Pulse sample indices are relative to their own slice.
+	/// </summary>
+	/// <param name="fragment">STMFragment to scan</param>
+	/// <param name="pulses">Output pulse records (appended)</param>
+	/// <param name="zsPayload">Optional buffer for the zero-suppressed payload (may be nullptr)</param>
+	/// <param name="zsCapacity">Capacity of zsPayload, in samples</param>
+	/// <returns>Number of samples written to zsPayload</returns>
+	size_t FindPulses(STMFragment const& fragment, std::vector<Pulse>& pulses, uint16_t* zsPayload = nullptr, size_t zsCapacity = 0) const;
+
+	Config const& GetConfig() const { return config_; }
+
+private:
+	bool IsOver(int16_t adc) const { return config_.negativePolarity ? adc < low_ : adc > high_; }
+	uint32_t OverMask16(int16_t const* adc) const;
+	// Scan one slice, counting the pulses stored without payload because zsPayload is full, so that the caller
+	// warns once
+	size_t ScanSlice(STMFragment::STMSlice const& slice, std::vector<Pulse>& pulses, uint16_t* zsPayload, size_t zsCapacity, size_t& noPayload) const;
+	void WarnPayloadFull(size_t zsCapacity, size_t noPayload) const;
+
+	Config config_;
+	int16_t high_;  ///< Samples above this are over threshold (positive polarity)
+	int16_t low_;   ///< Samples below this are over threshold (negative polarity)
+};
+
+}  // namespace mu2e
+
+#endif  // MU2E_ARTDAQ_CORE_OVERLAYS_STMZEROSUPPRESSOR_HH
@@ -4,6 +4,11 @@
 
 #include "artdaq-core/Data/Fragment.hh"
 
+#include <algorithm>
+#include <cstring>
+#include <optional>
+#include <vector>
+
 namespace mu2e {
 class TrkDtcFragment
 {
@@ -33,6 +38,19 @@ public:
 		uint32_t value;
 	};
 
+	/// <summary>
+	/// A register whose value differs between two dumps. A register present in only one of the dumps is reported
+	/// with the corresponding in* flag cleared and its value 0 on that side.
+	/// </summary>
+	struct RegDiff
+	{
+		uint32_t address;
+		uint32_t oldValue;
+		uint32_t newValue;
+		bool inOld;
+		bool inNew;
+	};
+
 	static_assert(sizeof(Metadata) == Metadata::size_words, "Metadata size changed!");
 
 	size_t nReg() const { return artdaq_fragment_.dataSizeBytes() / sizeof(RegEntry); }
@@ -55,8 +73,84 @@ public:
 	}
 	uint32_t val(int index) const { return getRegisterEntry(index).value; }
 
+	/// <summary>
+	/// Get the register entries sorted by address, building the index on first use. If an address appears more
+	/// than once in the dump, the last entry wins.
+	/// </summary>
+	std::vector<RegEntry> const& index() const
+	{
+		if (!index_built_)
+		{
+			auto begin = reinterpret_cast<RegEntry const*>(artdaq_fragment_.dataBeginBytes());
+			index_.assign(begin, begin + nReg());
+			std::stable_sort(index_.begin(), index_.end(), [](RegEntry const& a, RegEntry const& b) { return a.address < b.address; });
+			auto last = std::unique(index_.rbegin(), index_.rend(), [](RegEntry const& a, RegEntry const& b) { return a.address == b.address; });
+			index_.erase(index_.begin(), last.base());
+			index_built_ = true;
+		}
+		return index_;
+	}
+
+	/// <summary>
+	/// Look up a register by address, in O(log nReg())
+	/// </summary>
+	/// <param name="address">Register address</param>
+	/// <returns>Register value, or std::nullopt if the register is not in the dump</returns>
+	std::optional<uint32_t> valueAt(uint32_t address) const
+	{
+		auto const& idx = index();
+		auto it = std::lower_bound(idx.begin(), idx.end(), address, [](RegEntry const& a, uint32_t addr) { return a.address < addr; });
+		if (it == idx.end() || it->address != address) return std::nullopt;
+		return it->value;
+	}
+
+	/// <summary>
+	/// Compare two register dumps
+	/// </summary>
+	/// <param name="before">Earlier dump</param>
+	/// <param name="after">Later dump</param>
+	/// <returns>Changed, added and removed registers, sorted by address</returns>
+	static std::vector<RegDiff> diff(TrkDtcFragment const& before, TrkDtcFragment const& after)
+	{
+		std::vector<RegDiff> out;
+
+		// Dumps of the same DTC normally list the same registers in the same order
+		auto n = before.nReg();
+		if (n == after.nReg() && memcmp(before.artdaq_fragment_.dataBeginBytes(), after.artdaq_fragment_.dataBeginBytes(), n * sizeof(RegEntry)) == 0)
+		{
+			return out;
+		}
+
+		auto const& a = before.index();
+		auto const& b = after.index();
+		auto ia = a.begin();
+		auto ib = b.begin();
+		while (ia != a.end() || ib != b.end())
+		{
+			if (ib == b.end() || (ia != a.end() && ia->address < ib->address))
+			{
+				out.push_back({ia->address, ia->value, 0, true, false});
+				++ia;
+			}
+			else if (ia == a.end() || ib->address < ia->address)
+			{
+				out.push_back({ib->address, 0, ib->value, false, true});
+				++ib;
+			}
+			else
+			{
+				if (ia->value != ib->value) out.push_back({ia->address, ia->value, ib->value, true, true});
+				++ia;
+				++ib;
+			}
+		}
+		return out;
+	}
+
 private:
 	artdaq::Fragment const& artdaq_fragment_;
+	mutable std::vector<RegEntry> index_;
+	mutable bool index_built_{false};
 };
 }  // namespace mu2e
 